@@ -0,0 +1,259 @@
+#include "BenchSupport.h"
+#include "HexCodec.h"
+#include "logger.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+// Only errors reach the queue, so decode warnings on odd frames do not
+// turn into logging benchmarks; Logger::log is measured on its own.
+Logger logger("/dev/null", LOG_ERROR);
+
+// ============================================================
+//   ALLOCATION COUNTING
+// ============================================================
+//   Every global operator new bumps per-thread counters, so the
+//   logger's writer thread never shows up in a benchmark's numbers.
+
+namespace {
+
+thread_local AllocationStats allocations;
+
+void* countedAlloc(std::size_t size) {
+    allocations.count++;
+    allocations.bytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* countedAlignedAlloc(std::size_t size, std::align_val_t align) {
+    allocations.count++;
+    allocations.bytes += size;
+    const std::size_t a = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    allocations.count++;
+    allocations.bytes += size;
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+AllocationStats threadAllocations() {
+    return allocations;
+}
+
+FrameCounters::FrameCounters(benchmark::State& state) : state_(state), start_(threadAllocations()) {}
+
+void FrameCounters::finish(size_t framesPerIteration) {
+    const AllocationStats now = threadAllocations();
+    const double frames = static_cast<double>(state_.iterations()) * static_cast<double>(framesPerIteration);
+    if (frames == 0) return;
+    state_.counters["allocs/frame"] = static_cast<double>(now.count - start_.count) / frames;
+    state_.counters["bytes/frame"] = static_cast<double>(now.bytes - start_.bytes) / frames;
+    state_.SetItemsProcessed(static_cast<int64_t>(frames));
+}
+
+// ============================================================
+//   CORPUS
+// ============================================================
+
+std::string base64UrlEncode(std::string_view data) {
+    static constexpr char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::string out;
+    out.reserve((data.size() + 2) / 3 * 4);
+    size_t i = 0;
+    for (; i + 3 <= data.size(); i += 3) {
+        const uint32_t v = (static_cast<uint8_t>(data[i]) << 16) | (static_cast<uint8_t>(data[i + 1]) << 8) |
+                           static_cast<uint8_t>(data[i + 2]);
+        out += ALPHABET[v >> 18];
+        out += ALPHABET[(v >> 12) & 63];
+        out += ALPHABET[(v >> 6) & 63];
+        out += ALPHABET[v & 63];
+    }
+    // Gmail leaves the padding off
+    if (const size_t rest = data.size() - i; rest > 0) {
+        uint32_t v = static_cast<uint8_t>(data[i]) << 16;
+        if (rest == 2) v |= static_cast<uint8_t>(data[i + 1]) << 8;
+        out += ALPHABET[v >> 18];
+        out += ALPHABET[(v >> 12) & 63];
+        if (rest == 2) out += ALPHABET[(v >> 6) & 63];
+    }
+    return out;
+}
+
+namespace {
+
+constexpr size_t LARGE_MESSAGE_BYTES = 64 * 1024;
+
+std::string fixed(double value, int decimals) {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+    return buf;
+}
+
+std::string subjectOf(const EmailContent& t) {
+    return "Message " + std::to_string(t.momsn) + " from RockBLOCK " + t.imei;
+}
+
+// The notification as it arrives after the mailbox forwarding rule
+std::string renderEmailBody(const EmailContent& t) {
+    return "---------- Forwarded message ---------\r\n"
+           "From: " + t.imei + " <" + t.imei + "@rockblock.rock7.com>\r\n"
+           "Date: " + t.transmitTime + "\r\n"
+           "Subject: " + subjectOf(t) + "\r\n"
+           "To: <ascend-ground@example.edu>\r\n\r\n\r\n"
+           "IMEI: " + t.imei + "\r\n"
+           "MOMSN: " + std::to_string(t.momsn) + "\r\n"
+           "Transmit Time: " + t.transmitTime + " UTC\r\n"
+           "Iridium Latitude: " + fixed(t.iridiumLatitude, 4) + "\r\n"
+           "Iridium Longitude: " + fixed(t.iridiumLongitude, 4) + "\r\n"
+           "Iridium CEP: " + fixed(t.iridiumCep, 1) + "\r\n"
+           "Iridium Session Status: " + std::to_string(t.sessionStatus) + "\r\n"
+           "Data: " + t.hexData + "\r\n";
+}
+
+// Body followed by quoted forwarding history up to `bytes`
+std::string padWithHistory(std::string body, size_t bytes) {
+    for (int line = 1; body.size() < bytes; ++line) {
+        body += "> > Ground station relay " + std::to_string(line) +
+                ": no new frames in this window, forwarding unchanged.\r\n";
+    }
+    return body;
+}
+
+std::string renderHtml(const std::string& text) {
+    std::string html = "<div dir=\"ltr\">";
+    for (char c : text) {
+        if (c == '\n') html += "<br>";
+        else if (c == '<') html += "&lt;";
+        else if (c == '>') html += "&gt;";
+        else if (c != '\r') html += c;
+    }
+    return html + "</div>\r\n";
+}
+
+std::string renderGmailJson(const EmailContent& t, const std::string& body) {
+    const std::string html = renderHtml(body);
+    auto part = [](const char* partId, const char* mimeType, const std::string& content) {
+        return json{
+            {"partId", partId},
+            {"mimeType", mimeType},
+            {"filename", ""},
+            {"headers", json::array({ {{"name", "Content-Type"}, {"value", std::string(mimeType) + "; charset=\"UTF-8\""}} })},
+            {"body", {{"size", content.size()}, {"data", base64UrlEncode(content)}}}
+        };
+    };
+    json message = {
+        {"id", "18e5" + std::to_string(t.momsn)},
+        {"threadId", "18e5" + std::to_string(t.momsn)},
+        {"labelIds", json::array({"INBOX", "UNREAD"})},
+        {"snippet", body.substr(0, 120)},
+        {"payload", {
+            {"partId", ""},
+            {"mimeType", "multipart/alternative"},
+            {"filename", ""},
+            {"headers", json::array({
+                {{"name", "From"}, {"value", "Ascend Relay <relay@example.edu>"}},
+                {{"name", "To"}, {"value", "<ascend-ground@example.edu>"}},
+                {{"name", "Subject"}, {"value", "Fwd: " + subjectOf(t)}},
+                {{"name", "Date"}, {"value", t.transmitTime}}
+            })},
+            {"body", {{"size", 0}}},
+            {"parts", json::array({ part("0", "text/plain", body), part("1", "text/html", html) })}
+        }},
+        {"sizeEstimate", body.size() + html.size()},
+        {"historyId", "2650001"},
+        {"internalDate", "1742932212000"}
+    };
+    return message.dump();
+}
+
+std::string renderRockBlockForm(const EmailContent& t) {
+    std::string time;
+    for (char c : t.transmitTime) time += (c == ':') ? std::string("%3A") : std::string(1, c);
+    return "imei=" + t.imei + "&momsn=" + std::to_string(t.momsn) + "&transmit_time=" + time +
+           "&iridium_latitude=" + fixed(t.iridiumLatitude, 4) + "&iridium_longitude=" + fixed(t.iridiumLongitude, 4) +
+           "&iridium_cep=" + fixed(t.iridiumCep, 1) + "&data=" + t.hexData;
+}
+
+const char* corpusPath() {
+    const char* env = std::getenv("ASCEND_BENCH_CORPUS");
+    return (env && *env) ? env : ASCEND_BENCH_CORPUS;
+}
+
+std::vector<CorpusFrame> loadCorpus() {
+    std::vector<CorpusFrame> frames;
+    std::ifstream in(corpusPath());
+    json doc = json::parse(in, nullptr, false);
+    if (doc.is_discarded() || !doc.contains("telemetry")) {
+        std::fprintf(stderr, "Cannot read benchmark corpus %s\n", corpusPath());
+        std::exit(1);
+    }
+    for (const auto& row : doc["telemetry"]) {
+        CorpusFrame f;
+        EmailContent& t = f.telemetry;
+        t.isValid = true;
+        t.imei = row.value("imei", "");
+        t.momsn = row.value("momsn", 0);
+        t.transmitTime = row.value("transmitTime", "");
+        t.iridiumLatitude = row.value("iridiumLatitude", 0.0);
+        t.iridiumLongitude = row.value("iridiumLongitude", 0.0);
+        t.iridiumCep = row.value("iridiumCep", 0.0);
+        t.sessionStatus = row.value("sessionStatus", 0);
+        t.hexData = row.value("hexData", "");
+        HexCodec::Result hex = HexCodec::decode(t.hexData, f.frame);
+        if (!hex.ok()) continue;
+        f.frameSize = hex.bytesWritten;
+
+        f.emailBody = renderEmailBody(t);
+        f.gmailJson = renderGmailJson(t, f.emailBody);
+        f.largeGmailJson = renderGmailJson(t, padWithHistory(f.emailBody, LARGE_MESSAGE_BYTES));
+        f.rockBlockForm = renderRockBlockForm(t);
+        frames.push_back(std::move(f));
+    }
+    if (frames.empty()) {
+        std::fprintf(stderr, "Benchmark corpus %s has no usable frames\n", corpusPath());
+        std::exit(1);
+    }
+    return frames;
+}
+
+} // namespace
+
+const std::vector<CorpusFrame>& corpus() {
+    static const std::vector<CorpusFrame> frames = loadCorpus();
+    return frames;
+}
+
+int main(int argc, char** argv) {
+    logger.setConsoleOutput(false);  // keep the report readable
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::AddCustomContext("corpus", std::string(corpusPath()) + " (" +
+        std::to_string(corpus().size()) + " frames)");
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "Decoder.h"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ============================================================
+//   BENCHMARK CORPUS + ALLOCATION COUNTING
+// ============================================================
+//   The corpus is built at startup from the frames stored in
+//   dashboard/data/telemetry.json (ASCEND_BENCH_CORPUS overrides
+//   the path). Each stored frame is re-rendered into every form
+//   the daemon receives it in: the RockBLOCK email body, the Gmail
+//   messages.get JSON carrying that body base64url-encoded, and the
+//   RockBLOCK direct-delivery POST body.
+//
+//   Benchmarks handle one frame per iteration, cycling through the
+//   corpus, so the reported time is ns/frame. FrameCounters adds
+//   allocs/frame and bytes/frame (heap bytes requested) from the
+//   operator new counters in BenchSupport.cpp.
+// ============================================================
+
+struct CorpusFrame {
+    EmailContent telemetry;     // metadata as stored, payload not decoded
+    FrameBytes frame{};
+    size_t frameSize = 0;
+    std::string emailBody;      // forwarded RockBLOCK notification, CRLF lines
+    std::string gmailJson;      // messages.get response, text/plain + text/html parts
+    std::string largeGmailJson; // same frame under ~64 KiB of quoted forwarding history
+    std::string rockBlockForm;  // application/x-www-form-urlencoded POST body
+};
+
+const std::vector<CorpusFrame>& corpus();
+
+std::string base64UrlEncode(std::string_view data);
+
+// Heap allocations made by the calling thread so far
+struct AllocationStats {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+AllocationStats threadAllocations();
+
+// Snapshot at construction; finish() reports the allocations made since,
+// per frame, as the allocs/frame and bytes/frame counters and sets the
+// items-processed rate to frames/s.
+class FrameCounters {
+public:
+    explicit FrameCounters(benchmark::State& state);
+    void finish(size_t framesPerIteration = 1);
+
+private:
+    benchmark::State& state_;
+    AllocationStats start_;
+};
+
+// Cycles through the corpus: `const CorpusFrame& f = next();`
+class CorpusCursor {
+public:
+    const CorpusFrame& next() {
+        const CorpusFrame& f = frames_[i_];
+        if (++i_ == frames_.size()) i_ = 0;
+        return f;
+    }
+
+private:
+    const std::vector<CorpusFrame>& frames_ = corpus();
+    size_t i_ = 0;
+};
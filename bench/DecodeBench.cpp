@@ -0,0 +1,74 @@
+#include "BenchSupport.h"
+#include "HexCodec.h"
+#include <vector>
+
+// ============================================================
+//   DECODE PIPELINE — email / POST body to PayloadData
+// ============================================================
+
+// Full RockBLOCK email: field scan, number parsing, hex decode, projection
+static void BM_ParseEmail(benchmark::State& state) {
+    Decoder decoder;
+    CorpusCursor frames;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        EmailContent t = decoder.parseEmail(frames.next().emailBody);
+        benchmark::DoNotOptimize(t);
+    }
+    counters.finish();
+}
+BENCHMARK(BM_ParseEmail);
+
+static void BM_ParseRockBlockForm(benchmark::State& state) {
+    Decoder decoder;
+    CorpusCursor frames;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        EmailContent t = decoder.parseRockBlockForm(frames.next().rockBlockForm);
+        benchmark::DoNotOptimize(t);
+    }
+    counters.finish();
+}
+BENCHMARK(BM_ParseRockBlockForm);
+
+// 100 hex digits to the 50 frame bytes
+static void BM_HexDecode(benchmark::State& state) {
+    CorpusCursor frames;
+    FrameBytes out;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        HexCodec::Result r = HexCodec::decode(frames.next().telemetry.hexData, out);
+        benchmark::DoNotOptimize(r);
+        benchmark::DoNotOptimize(out);
+    }
+    counters.finish();
+}
+BENCHMARK(BM_HexDecode);
+
+static void BM_DecodeHexPayload(benchmark::State& state) {
+    Decoder decoder;
+    CorpusCursor frames;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        PayloadData p = decoder.decodeHexPayload(frames.next().telemetry.hexData);
+        benchmark::DoNotOptimize(p);
+    }
+    counters.finish();
+}
+BENCHMARK(BM_DecodeHexPayload);
+
+// Archive replay path: the whole corpus per iteration on one thread
+static void BM_DecodeBatch(benchmark::State& state) {
+    Decoder decoder;
+    std::vector<FrameBytes> input;
+    for (const CorpusFrame& f : corpus()) input.push_back(f.frame);
+    std::vector<PayloadData> out(input.size());
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        size_t valid = decoder.decodeBatch(input, out, TxLayoutVersion::Auto, 1);
+        benchmark::DoNotOptimize(valid);
+        benchmark::DoNotOptimize(out.data());
+    }
+    counters.finish(input.size());
+}
+BENCHMARK(BM_DecodeBatch);
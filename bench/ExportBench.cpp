@@ -0,0 +1,76 @@
+#include "BenchSupport.h"
+#include "TelemetryExporter.h"
+#include "TelemetryStore.h"
+
+// ============================================================
+//   STORE + JSON EXPORT
+// ============================================================
+
+namespace {
+
+// The corpus decoded and stored `copies` times over (MOMSNs offset so
+// every row is distinct)
+TelemetryStore buildStore(size_t copies) {
+    Decoder decoder;
+    TelemetryStore store;
+    store.reserve(copies * corpus().size());
+    for (size_t c = 0; c < copies; ++c) {
+        for (const CorpusFrame& f : corpus()) {
+            EmailContent t = f.telemetry;
+            t.momsn += static_cast<int>(c * 100000);
+            t.payload = decoder.decodeFrame(std::span<const uint8_t>(f.frame.data(), f.frameSize));
+            store.append(t, f.frame, f.frameSize);
+        }
+    }
+    return store;
+}
+
+} // namespace
+
+// One NDJSON line / SSE event: what exportNew and DashboardServer::publish do per row
+static void BM_ExportRowJson(benchmark::State& state) {
+    const TelemetryStore store = buildStore(1);
+    size_t i = 0;
+    int64_t bytes = 0;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        std::string line = TelemetryExporter::rowToJson(store, i).dump(-1, ' ', true);
+        benchmark::DoNotOptimize(line);
+        bytes += static_cast<int64_t>(line.size());
+        if (++i == store.size()) i = 0;
+    }
+    counters.finish();
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_ExportRowJson);
+
+// Decoded frame into the column store (IMEI interning, dedup key, columns)
+static void BM_StoreAppend(benchmark::State& state) {
+    Decoder decoder;
+    std::vector<EmailContent> decoded;
+    for (const CorpusFrame& f : corpus()) {
+        EmailContent t = f.telemetry;
+        t.payload = decoder.decodeFrame(std::span<const uint8_t>(f.frame.data(), f.frameSize));
+        decoded.push_back(std::move(t));
+    }
+    constexpr size_t STORE_ROWS = 1 << 16;  // start over so memory stays flat
+    TelemetryStore store;
+    store.reserve(STORE_ROWS);
+    size_t i = 0;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        const CorpusFrame& f = corpus()[i % decoded.size()];
+        EmailContent& t = decoded[i % decoded.size()];
+        t.momsn = static_cast<int>(i);  // unique within this store
+        store.append(t, f.frame, f.frameSize);
+        if (++i == STORE_ROWS) {
+            state.PauseTiming();
+            store = TelemetryStore();
+            store.reserve(STORE_ROWS);
+            i = 0;
+            state.ResumeTiming();
+        }
+    }
+    counters.finish();
+}
+BENCHMARK(BM_StoreAppend);
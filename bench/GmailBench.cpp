@@ -0,0 +1,115 @@
+#include "BenchSupport.h"
+#include "Base64.h"
+#include "GmailClient.h"
+#include "ScratchArena.h"
+#include <algorithm>
+
+// ============================================================
+//   GMAIL MESSAGE HANDLING — messages.get JSON to body text
+// ============================================================
+//   Arg 0 = one notification (~1 KiB of JSON), arg 1 = the same
+//   frame under ~64 KiB of quoted forwarding history. Bytes/s is
+//   over the JSON (parse) or the base64url text (decode).
+
+namespace {
+
+const std::string& messageJson(const CorpusFrame& f, int64_t large) {
+    return large ? f.largeGmailJson : f.gmailJson;
+}
+
+// The text/plain body.data field of a generated message
+std::string plainPartData(const std::string& messageJson) {
+    const std::string marker = "\"data\":\"";
+    size_t begin = messageJson.find(marker) + marker.size();
+    return messageJson.substr(begin, messageJson.find('"', begin) - begin);
+}
+
+} // namespace
+
+static void BM_DecodeBase64Url(benchmark::State& state) {
+    std::vector<std::string> encoded;
+    for (const CorpusFrame& f : corpus()) encoded.push_back(plainPartData(messageJson(f, state.range(0))));
+    size_t i = 0;
+    int64_t bytes = 0;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        const std::string& data = encoded[i];
+        if (++i == encoded.size()) i = 0;
+        std::string body = GmailClient::decodeBase64Url(data);
+        benchmark::DoNotOptimize(body);
+        bytes += static_cast<int64_t>(data.size());
+    }
+    counters.finish();
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_DecodeBase64Url)->Arg(0)->Arg(1);
+
+// The decoder alone, into a reused buffer: no allocation per message
+static void BM_Base64Decode(benchmark::State& state) {
+    std::vector<std::string> encoded;
+    size_t longest = 0;
+    for (const CorpusFrame& f : corpus()) {
+        encoded.push_back(plainPartData(messageJson(f, state.range(0))));
+        longest = std::max(longest, encoded.back().size());
+    }
+    std::vector<uint8_t> out(Base64::decodedSize(longest));
+    size_t i = 0;
+    int64_t bytes = 0;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        const std::string& data = encoded[i];
+        if (++i == encoded.size()) i = 0;
+        Base64::Result r = Base64::decode(data, out);
+        benchmark::DoNotOptimize(r);
+        benchmark::DoNotOptimize(out.data());
+        bytes += static_cast<int64_t>(data.size());
+    }
+    counters.finish();
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_Base64Decode)->Arg(0)->Arg(1);
+
+// Body extraction: SAX walk of the message plus base64url of both parts,
+// everything on the heap
+static void BM_ParseMessage(benchmark::State& state) {
+    CorpusCursor frames;
+    int64_t bytes = 0;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        const std::string& json = messageJson(frames.next(), state.range(0));
+        GmailMessage message = GmailClient::parseResponse(json);
+        benchmark::DoNotOptimize(message);
+        bytes += static_cast<int64_t>(json.size());
+    }
+    counters.finish();
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_ParseMessage)->Arg(0)->Arg(1);
+
+// One message as the daemon handles it: parsed into the thread's scratch
+// arena, telemetry extracted, arena reset. allocs/frame is what still
+// reaches the global allocator; arenaSpills/frame is what the arena had
+// to take from the heap (block growth included).
+static void BM_IngestMessage(benchmark::State& state) {
+    CorpusCursor frames;
+    Decoder decoder;
+    ScratchArena& scratch = ScratchArena::forThread();
+    const uint64_t spillsBefore = scratch.stats().heapAllocations;
+    int64_t bytes = 0;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        const std::string& json = messageJson(frames.next(), state.range(0));
+        {
+            GmailMessage message = GmailClient::parseResponse(json, scratch.resource());
+            EmailContent telemetry = decoder.parseEmail(message.bodyText);
+            benchmark::DoNotOptimize(telemetry);
+        }
+        scratch.reset();
+        bytes += static_cast<int64_t>(json.size());
+    }
+    counters.finish();
+    state.counters["arenaSpills/frame"] = benchmark::Counter(
+        static_cast<double>(scratch.stats().heapAllocations - spillsBefore), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_IngestMessage)->Arg(0)->Arg(1);
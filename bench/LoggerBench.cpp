@@ -0,0 +1,49 @@
+#include "BenchSupport.h"
+#include "logger.h"
+
+extern Logger logger;
+
+// ============================================================
+//   LOGGER — producer-side cost of a log line
+// ============================================================
+//   The writer thread drains to /dev/null; when it falls behind the
+//   ring fills and log() waits, so sustained throughput is included.
+
+// A decode-sized line through logger.log
+static void BM_LoggerLog(benchmark::State& state) {
+    CorpusCursor frames;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        const CorpusFrame& f = frames.next();
+        logger.log(LOG_ERROR, "Parsed email - MOMSN: " + std::to_string(f.telemetry.momsn));
+    }
+    counters.finish();
+}
+BENCHMARK(BM_LoggerLog);
+
+// Same line through ASCEND_LOG with formatting
+static void BM_AscendLog(benchmark::State& state) {
+    CorpusCursor frames;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        const CorpusFrame& f = frames.next();
+        ASCEND_LOG(LOG_ERROR, "Parsed email - MOMSN: {} at {:.4f}, {:.4f}", f.telemetry.momsn,
+            f.telemetry.iridiumLatitude, f.telemetry.iridiumLongitude);
+    }
+    counters.finish();
+}
+BENCHMARK(BM_AscendLog);
+
+// Below the runtime level: the check the decoder pays per suppressed line
+static void BM_AscendLogFiltered(benchmark::State& state) {
+    CorpusCursor frames;
+    FrameCounters counters(state);
+    for (auto _ : state) {
+        const CorpusFrame& f = frames.next();
+        ASCEND_LOG(LOG_INFO, "Parsed email - MOMSN: {} at {:.4f}, {:.4f}", f.telemetry.momsn,
+            f.telemetry.iridiumLatitude, f.telemetry.iridiumLongitude);
+        benchmark::ClobberMemory();  // re-read the level every time, as a real caller would
+    }
+    counters.finish();
+}
+BENCHMARK(BM_AscendLogFiltered);
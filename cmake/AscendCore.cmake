@@ -0,0 +1,31 @@
+# ascend_core: everything but main.cpp, shared by the daemon and bench/.
+# Included by the top-level CMakeLists.txt and by bench/ when that is
+# configured on its own, so the source list lives only here. Expects the
+# nlohmann_json, CURL and Threads packages to be found already.
+
+get_filename_component(ASCEND_ROOT ${CMAKE_CURRENT_LIST_DIR}/.. ABSOLUTE)
+
+add_library(ascend_core STATIC
+    ${ASCEND_ROOT}/src/Base64.cpp
+    ${ASCEND_ROOT}/src/DashboardServer.cpp
+    ${ASCEND_ROOT}/src/Decoder.cpp
+    ${ASCEND_ROOT}/src/FrameRegistry.cpp
+    ${ASCEND_ROOT}/src/GmailAuth.cpp
+    ${ASCEND_ROOT}/src/GmailBatch.cpp
+    ${ASCEND_ROOT}/src/GmailClient.cpp
+    ${ASCEND_ROOT}/src/HexCodec.cpp
+    ${ASCEND_ROOT}/src/HttpServer.cpp
+    ${ASCEND_ROOT}/src/HttpSession.cpp
+    ${ASCEND_ROOT}/src/IngestEvents.cpp
+    ${ASCEND_ROOT}/src/ScratchArena.cpp
+    ${ASCEND_ROOT}/src/TelemetryArchive.cpp
+    ${ASCEND_ROOT}/src/TelemetryExporter.cpp
+    ${ASCEND_ROOT}/src/TelemetryStore.cpp
+    ${ASCEND_ROOT}/src/logger.cpp
+)
+target_include_directories(ascend_core PUBLIC ${ASCEND_ROOT}/include)
+target_link_libraries(ascend_core PUBLIC nlohmann_json::nlohmann_json CURL::libcurl Threads::Threads)
+target_compile_options(ascend_core PRIVATE -Wall -Wextra)
+if(ASCEND_LOG_MIN_LEVEL)
+    target_compile_definitions(ascend_core PUBLIC ASCEND_LOG_MIN_LEVEL=${ASCEND_LOG_MIN_LEVEL})
+endif()
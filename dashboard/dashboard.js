@@ -10,7 +10,12 @@ let flightPath = null;
 let markers = [];
 let charts = {};
 let lastCount = 0;
-let lastLogCount = 0;
+let loadedBytes = 0;   // prefix of telemetry.ndjson already parsed
+let lastLogSeq = 0;
+let useApi = location.protocol.startsWith('http');  // served by the daemon: delta endpoints
+let telemetryEtag = null;
+let logsEtag = null;
+let liveStream = null;   // EventSource on /stream while served by the daemon
 let currentLogFilter = 'ALL';
 let autoScrollLogs = true;
 let mapInitialized = false;
@@ -18,8 +23,13 @@ let isFirstLoad = true;
 const startTime = Date.now();
 
 const REFRESH_INTERVAL = 3000;
-const TELEMETRY_URL = 'data/telemetry.json';
+const TELEMETRY_URL = 'data/telemetry.ndjson';
+const MANIFEST_URL = 'data/telemetry.manifest.json';
 const LOGS_URL = 'data/logs.json';
+const API_TELEMETRY_URL = 'telemetry';
+const API_LOGS_URL = 'logs';
+const API_STREAM_URL = 'stream';
+const MAX_LOG_LINES = 500;
 
 // ── Byte regions for the 50-byte hex display ──
 // [0..1] HDR  [2..4] SER  [5] DATALINK  [6..21] GNSS
@@ -101,32 +111,118 @@ async function loadData() { await loadTelemetry(); await loadLogs(); }
 
 async function loadTelemetry() {
     try {
-        const res = await fetch(TELEMETRY_URL + '?t=' + Date.now());
-        if (!res.ok) throw new Error(`HTTP ${res.status}`);
-        const data = await res.json();
-        if (data.telemetry && data.telemetry.length > 0) {
-            telemetryData = data.telemetry;
-            document.getElementById('loading').style.display = 'none';
-            document.getElementById('dashboard').style.display = 'block';
-            if (isFirstLoad && !map) {
-                initMap();
-                setTimeout(() => { if (map) map.invalidateSize(); updateDashboard(data); }, 100);
-            } else {
-                updateDashboard(data);
-            }
+        if (useApi) {
+            // The live stream delivers new frames; polling only covers gaps
+            if (liveStream && liveStream.readyState === EventSource.OPEN) return;
+            const data = await fetchTelemetryDelta();
+            if (data) showTelemetry(data);
+            if (useApi) { openLiveStream(); return; }
         }
+        const data = await fetchTelemetryFile();
+        if (data) showTelemetry(data);
     } catch (e) { console.error('[ERR] Load:', e); }
 }
 
+// Daemon endpoint: only records after the ones already held, 304 when none.
+// Returns null when nothing changed; switches to file mode if there is no API.
+async function fetchTelemetryDelta() {
+    let res;
+    try {
+        res = await fetch(`${API_TELEMETRY_URL}?since=${telemetryData.length}`, {
+            headers: telemetryEtag ? { 'If-None-Match': telemetryEtag } : {}
+        });
+    } catch (e) { useApi = false; return null; }
+    if (res.status === 304) return null;
+    if (!res.ok) { useApi = false; return null; }
+    const data = await res.json();
+    telemetryEtag = res.headers.get('ETag');
+    if (data.reset) telemetryData = [];
+    if (data.records.length === 0) return null;
+    for (const r of data.records) telemetryData.push(r);
+    return data;
+}
+
+// Static files: the manifest says how many bytes of the NDJSON file are
+// complete; only the part after loadedBytes is fetched (Range) and parsed.
+async function fetchTelemetryFile() {
+    const mres = await fetch(MANIFEST_URL + '?t=' + Date.now());
+    if (!mres.ok) throw new Error(`HTTP ${mres.status}`);
+    const data = await mres.json();
+    if (data.bytes < loadedBytes) {   // daemon restarted with a fresh file
+        telemetryData = [];
+        loadedBytes = 0;
+    }
+    if (data.bytes === loadedBytes) return null;
+
+    const res = await fetch(TELEMETRY_URL + '?t=' + Date.now(), {
+        headers: { Range: `bytes=${loadedBytes}-${data.bytes - 1}` }
+    });
+    if (!res.ok) throw new Error(`HTTP ${res.status}`);
+    let text = await res.text();
+    // Servers without Range support send the whole file
+    text = res.status === 206 ? text.slice(0, data.bytes - loadedBytes)
+                              : text.slice(loadedBytes, data.bytes);
+    for (const line of text.split('\n')) {
+        if (line) telemetryData.push(JSON.parse(line));
+    }
+    loadedBytes = data.bytes;
+    return data;
+}
+
+// Server-Sent Events: each "telemetry" event is one record, id = its 1-based
+// position. Events that don't extend telemetryData by exactly one are left
+// to the delta poll. EventSource reconnects with Last-Event-ID on its own.
+function openLiveStream() {
+    if (liveStream || !window.EventSource) return;
+    liveStream = new EventSource(`${API_STREAM_URL}?since=${telemetryData.length}`);
+    liveStream.addEventListener('telemetry', e => {
+        if (Number(e.lastEventId) !== telemetryData.length + 1) return;
+        telemetryData.push(JSON.parse(e.data));
+        showTelemetry({ lastUpdated: Date.now() / 1000, totalRecords: telemetryData.length });
+    });
+    liveStream.addEventListener('reset', () => {   // daemon restarted
+        telemetryData = [];
+        telemetryEtag = null;
+    });
+}
+
+function showTelemetry(data) {
+    if (telemetryData.length === 0) return;
+    document.getElementById('loading').style.display = 'none';
+    document.getElementById('dashboard').style.display = 'block';
+    if (isFirstLoad && !map) {
+        initMap();
+        setTimeout(() => { if (map) map.invalidateSize(); updateDashboard(data); }, 100);
+    } else {
+        updateDashboard(data);
+    }
+}
+
 async function loadLogs() {
     try {
+        if (useApi) {
+            const res = await fetch(`${API_LOGS_URL}?since=${lastLogSeq}`, {
+                headers: logsEtag ? { 'If-None-Match': logsEtag } : {}
+            });
+            if (res.status === 304 || !res.ok) return;
+            logsEtag = res.headers.get('ETag');
+            const data = await res.json();
+            if (data.lastSeq < lastLogSeq) logsData = [];   // daemon restarted
+            if (data.logs.length > 0) {
+                logsData = logsData.concat(data.logs).slice(-MAX_LOG_LINES);
+                updateLogDisplay();
+            }
+            lastLogSeq = data.lastSeq;
+            return;
+        }
         const res = await fetch(LOGS_URL + '?t=' + Date.now());
         if (!res.ok) return;
         const data = await res.json();
-        if (data.logs && data.logs.length > 0 && data.logs.length !== lastLogCount) {
+        // The file only holds the newest 500 lines, so compare sequence numbers, not counts
+        if (data.logs && data.logs.length > 0 && data.lastSeq !== lastLogSeq) {
             logsData = data.logs;
             updateLogDisplay();
-            lastLogCount = data.logs.length;
+            lastLogSeq = data.lastSeq;
         }
     } catch (e) { /* logs optional */ }
 }
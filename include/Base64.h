@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+// ============================================================
+//   BASE64 / BASE64URL -> BYTES
+// ============================================================
+//   Decodes Gmail body.data (base64url, no padding) and any other
+//   base64 text into a caller-provided buffer, or over the input
+//   string itself. Nothing is allocated.
+//
+//   - Both alphabets are accepted: '-' or '+' is 62, '_' or '/' is 63.
+//   - Trailing '=' padding is optional; decoding stops at the first '='.
+//   - ASCII whitespace is skipped (MIME-wrapped lines).
+//   - Any other character stops the decode and is reported by position;
+//     the bytes decoded before it are kept.
+//   - Runs of clean characters go through an SSSE3 (or AVX2 when the
+//     CPU has it) block decoder, 16/32 chars to 12/24 bytes; the rest
+//     uses a 256-entry table.
+// ============================================================
+
+namespace Base64 {
+
+enum class Status : uint8_t {
+    Ok,
+    InvalidChar,  // errorPos = offset of the offending character
+    BadLength,    // errorPos = offset of a lone final character (6 bits, no byte)
+    Overflow      // errorPos = offset of the first character that did not fit
+};
+
+struct Result {
+    Status status       = Status::Ok;
+    size_t bytesWritten = 0;
+    size_t errorPos     = 0;
+
+    bool ok() const { return status == Status::Ok; }
+};
+
+// Upper bound on the decoded size of `encodedLength` characters
+constexpr size_t decodedSize(size_t encodedLength) {
+    return encodedLength / 4 * 3 + (encodedLength % 4) * 3 / 4;
+}
+
+// Block decoders decode() may use. It picks the best one the CPU has;
+// a lower level is for differential tests and benchmarks. Levels the
+// CPU lacks fall back to the best it has.
+enum class Simd : uint8_t { None, Ssse3, Avx2 };
+Simd bestSimd();
+
+// `in` and `out` may start at the same address (see decodeInPlace)
+Result decode(std::string_view in, std::span<uint8_t> out);
+Result decode(std::string_view in, std::span<uint8_t> out, Simd simd);
+
+// Decodes `text` over itself and shrinks it to the decoded bytes
+// (std::string or std::pmr::string)
+template <typename Allocator>
+Result decodeInPlace(std::basic_string<char, std::char_traits<char>, Allocator>& text) {
+    const Result r = decode(text, std::span<uint8_t>(reinterpret_cast<uint8_t*>(text.data()), text.size()));
+    text.resize(r.bytesWritten);
+    return r;
+}
+
+const char* statusString(Status status);
+
+}
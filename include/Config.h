@@ -10,6 +10,22 @@ const int POLL_INTERVAL_MINUTES = 1; // Modem sends every 5 min; 1 min poll catc
 
 const std::string PATH_TO_SECRET = "env/client_secret.json";
 const std::string PATH_TO_TOKEN  = "env/token_cache.json";
+// Google endpoints; point these at a local HTTPS stand-in to test without Gmail
+const std::string GMAIL_API_BASE_URL = "https://gmail.googleapis.com/gmail/v1/users/me";
+const std::string OAUTH_TOKEN_URL    = "https://oauth2.googleapis.com/token";
+const std::string GMAIL_BATCH_URL    = "https://gmail.googleapis.com/batch/gmail/v1";
+const int MAX_CONCURRENT_FETCHES = 8; // message bodies fetched in parallel after a gap
+const int GMAIL_BATCH_SIZE = 50;      // messages per batch request, 0 = don't use the batch endpoint
+
+const std::string PATH_TO_HISTORY_CHECKPOINT = "env/history_checkpoint.json"; // Gmail historyId, empty = after: search polling
+// HTTP listener: push webhooks (Gmail Pub/Sub, RockBLOCK POST) and the dashboard at http://HTTP_BIND_ADDRESS:HTTP_PORT/;
+// polling stays on as the fallback
+const std::string HTTP_BIND_ADDRESS = "127.0.0.1";
+const int HTTP_PORT = 8080;          // 0 = no listener, poll only
+const std::string PUSH_TOKEN = "";   // required as ?token= on push URLs when set
+
+const std::string PATH_TO_FRAME_LAYOUTS = "env/frame_layouts.json"; // optional MOMSN range -> TX array revision
+const std::string PATH_TO_TELEMETRY_ARCHIVE = "env/telemetry_archive.bin"; // raw frames, replayed into the store at startup
 
 // All payload structures, byte indices, and sensor calibration
 // constants are now defined in Decoder.h
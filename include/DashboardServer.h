@@ -0,0 +1,52 @@
+#pragma once
+#include "HttpServer.h"
+#include "TelemetryStore.h"
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ============================================================
+//   DASHBOARD SERVER — static files plus delta endpoints
+// ============================================================
+//   GET /telemetry?since=N   records N.. of this run, oldest first:
+//                            { lastUpdated, totalRecords, next, reset, records: [...] }
+//                            N is the number of records the client already
+//                            holds (MOMSN is not monotonic across modems and
+//                            direct/mail delivery, the store order is).
+//   GET /logs?since=SEQ      log lines with seq > SEQ, same shape as logs.json
+//   GET /stream?since=N      Server-Sent Events: one "telemetry" event per
+//                            record as soon as it is published, id = N + 1.
+//                            Reconnects resume from Last-Event-ID.
+//   GET /<file>              files under the dashboard directory
+//
+//   Every reply carries an ETag naming the state it was built from;
+//   a matching If-None-Match gets 304 with no body, so an idle
+//   dashboard costs a few hundred bytes per poll.
+//
+//   publish() runs on the main thread for every stored frame; the
+//   handlers run on server threads and only read the cached rows,
+//   which double as the event log the streams replay from.
+// ============================================================
+
+class DashboardServer {
+public:
+    // Registers the routes; call before server.start()
+    DashboardServer(HttpServer& server, std::string staticDir);
+
+    // Serializes rows added to the store since the last call
+    void publish(const TelemetryStore& store);
+
+private:
+    HttpReply telemetry(const HttpRequest& req) const;
+    HttpReply logs(const HttpRequest& req) const;
+    HttpReply staticFile(const HttpRequest& req) const;
+    void stream(const HttpRequest& req, HttpStream& out) const;
+
+    std::string staticDir_;
+    mutable std::mutex mutex_;
+    mutable std::condition_variable published_;   // wakes /stream clients
+    std::vector<std::string> rows_;   // one JSON object per store row
+    time_t lastUpdated_ = 0;
+};
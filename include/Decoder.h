@@ -2,113 +2,11 @@
 #include <string>
 #include <vector>
 #include <cstdint>
-
-// ============================================================
-//   RECEIVED HEX PAYLOAD — 50 bytes total
-// ============================================================
-//   [0..1]   "RB" header         (modem manufacturer)
-//   [2..4]   Serial number       (modem manufacturer, 3 bytes big-endian)
-//   [5..49]  TX array            (our 45 bytes from buildIridiumTxArray)
-//
-//   TX ARRAY v4.2.4 layout at offset +5:
-//   [5]      Datalink byte  (0=good BT link, 1=bad BT link)
-//   [6..21]  GNSS from BT slave (lastValidBtRx[0..15])
-//              [6]  UTC Hours   [7]  UTC Min    [8]  UTC Sec
-//              [9]  Lat°  [10] Lat'  [11] Lat"  [12] Lat hemi (0=N 1=S)
-//              [13] Lon°  [14] Lon'  [15] Lon"  [16] Lon hemi (0=E 1=W)
-//              [17..20] Altitude (4-byte big-endian)
-//              [21] Altitude units (0=m 1=ft)
-//   [22..37] I2C sensor block (latestI2Cblock[0..15])
-//              [22] Radio sweep count (0-255 wrapping)
-//              [23..25] AHT20 Hum  (20-bit raw)
-//              [26..28] AHT20 Temp (20-bit raw)
-//              [29] AHT20 status (2=OK 3=fail 4=timeout)
-//              [30..31] Radio current station idx (MSB/LSB)
-//              [32] Radio current signal (0-15)
-//              [33] Radio stereo flag (1=stereo 0=mono)
-//              [34] Datalink byte copy (mirrors TX[5])
-//              [35] Radio peak signal this sweep (0-15)
-//              [36..37] Radio peak station idx (MSB/LSB)
-//   [38]     Reserved (0x00)
-//   [39..40] Master battery ADC (MSB/LSB) — analogRead(29) on RP2040
-//   [41..42] Internal temp ADC  (MSB/LSB) — fdr.ADCread(port 4)
-//   [43..44] External temp ADC  (MSB/LSB) — fdr.ADCread(port 3)
-//   [45..46] Slave battery ADC  (MSB/LSB) — slave fdr.ADCread(7) via BT
-//   [47]     Current modem return code  (low byte)
-//   [48]     Previous modem return code (low byte)
-//   [49]     Cumulative TX success count
-// ============================================================
-
-namespace PayloadIndex {
-    // Manufacturer bytes
-    constexpr int HEADER_BYTE_0     = 0;
-    constexpr int HEADER_BYTE_1     = 1;
-    constexpr int SERIAL_BYTE_0     = 2;
-    constexpr int SERIAL_BYTE_1     = 3;
-    constexpr int SERIAL_BYTE_2     = 4;
-
-    // TX offset
-    constexpr int TX_OFFSET         = 5;
-    constexpr int DATALINK_BYTE     = 5;   // 0=good BT link, 1=bad BT link
-    constexpr int MODEM_CURRENT_MSB = 38;  // TX[33] — current modem code high byte
-    // MODEM_PREVIOUS: use MODEM_PREVIOUS_MSB (48) + MODEM_PREVIOUS_LSB (49) for full 16-bit
-    constexpr int MODEM_CURRENT_LSB  = 47;  // TX[42] — current modem code low byte
-    constexpr int MODEM_PREVIOUS_MSB = 48;  // TX[43] — previous modem code high byte
-    constexpr int MODEM_PREVIOUS_LSB = 49;  // TX[44] — previous modem code low byte
-
-    // GNSS [6..21]
-    constexpr int UTC_HOURS         = 6;
-    constexpr int UTC_MINUTES       = 7;
-    constexpr int UTC_SECONDS       = 8;
-    constexpr int LAT_DEGREES       = 9;
-    constexpr int LAT_MINUTES       = 10;
-    constexpr int LAT_SECONDS       = 11;
-    constexpr int LAT_HEMISPHERE    = 12;
-    constexpr int LON_DEGREES       = 13;
-    constexpr int LON_MINUTES       = 14;
-    constexpr int LON_SECONDS       = 15;
-    constexpr int LON_HEMISPHERE    = 16;
-    constexpr int ALT_BYTE_0        = 17;
-    constexpr int ALT_BYTE_1        = 18;
-    constexpr int ALT_BYTE_2        = 19;
-    constexpr int ALT_BYTE_3        = 20;
-    constexpr int ALT_UNITS         = 21;
-
-    // I2C block [22..37]
-    constexpr int RADIO_SWEEP_COUNT = 22;  // FM scan sweep counter (wraps 0-255)
-    constexpr int AHT20_HUM_0       = 23;
-    constexpr int AHT20_HUM_1       = 24;
-    constexpr int AHT20_HUM_2       = 25;
-    constexpr int AHT20_TEMP_0      = 26;
-    constexpr int AHT20_TEMP_1      = 27;
-    constexpr int AHT20_TEMP_2      = 28;
-    constexpr int AHT20_STATUS      = 29;
-    constexpr int RADIO_STATION_MSB = 30;
-    constexpr int RADIO_STATION_LSB = 31;
-    constexpr int RADIO_SIGNAL      = 32;
-    constexpr int RADIO_STEREO      = 33;
-    constexpr int I2C_DATALINK      = 34;  // mirrors DATALINK_BYTE at [5]
-    constexpr int RADIO_PEAK_SIGNAL = 35;  // highest signal seen this sweep (0-15)
-    constexpr int I2C_MODEM_MSB     = 36;  // last modem return code MSB (MODEM 2.0)
-    constexpr int I2C_MODEM_LSB     = 37;  // last modem return code LSB — decode: (MSB<<8)|LSB
-
-    // Analog [39..46]
-    constexpr int RESERVED_38       = 38;
-    constexpr int MASTER_BATT_MSB   = 39;
-    constexpr int MASTER_BATT_LSB   = 40;
-    constexpr int INT_TEMP_MSB      = 41;
-    constexpr int INT_TEMP_LSB      = 42;
-    constexpr int EXT_TEMP_MSB      = 43;
-    constexpr int EXT_TEMP_LSB      = 44;
-    constexpr int SLAVE_BATT_MSB    = 45;
-    constexpr int SLAVE_BATT_LSB    = 46;
-
-    // Modem [47..49]
-    constexpr int MODEM_CURRENT     = 47;
-    constexpr int MODEM_PREVIOUS    = 48;
-    constexpr int TX_RESERVED_44    = 44;  // was TX count, now 0x00 — dashboard counts by MOMSN
-    constexpr int EXPECTED_SIZE     = 50;
-}
+#include <array>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include "FrameLayout.h"
 
 namespace SensorCal {
     // ── Master battery ────────────────────────────────────────────────────
@@ -132,6 +30,8 @@ namespace SensorCal {
     constexpr float SLAVE_ADC_TO_VOLTAGE     = 0.0001875f;  // V/count (slave FDR ADC)
     constexpr float SLAVE_BATT_DIVIDER_RATIO = 11.46f;      // voltage divider on slave port 7
     constexpr float SLAVE_BATT_VOLT_PER_COUNT = 0.002149f;  // combined constant (V/count)
+    // v4.1 frames: slave battery = raw * FDR_ADC_TO_VOLTAGE * V41_SLAVE_BATT_SCALE
+    constexpr float V41_SLAVE_BATT_SCALE     = 1.049f;
 
     // ── Temperature calibration ───────────────────────────────────────────
     // tempC = (V_measured - OFFSET) / SCALE
@@ -152,7 +52,7 @@ struct AHT20Data {
     uint8_t status   = 0;
     bool isValid     = false;
 
-    std::string statusString() const {
+    constexpr std::string_view statusString() const {
         switch (status) {
             case 2: return "OK";
             case 3: return "FAIL";
@@ -173,43 +73,144 @@ struct RadioData {
     uint8_t  sweepCount  = 0;
 };
 
+// Which analog channel a reading came from; name and unit text are
+// looked up from the kind when the reading is rendered
+enum class SensorKind : uint8_t {
+    MasterBattery,
+    SlaveBattery,
+    InternalTemp,
+    ExternalTemp,
+    Count
+};
+
+enum class SensorUnit : uint8_t {
+    Volts,
+    Celsius   // rendered with the Fahrenheit value, "°C (72°F)"
+};
+
+struct SensorInfo {
+    std::string_view name;
+    SensorUnit unit;
+};
+
+constexpr SensorInfo SENSOR_INFO[] = {
+    { "Master Battery",       SensorUnit::Volts },
+    { "Slave Battery",        SensorUnit::Volts },
+    { "Internal Temperature", SensorUnit::Celsius },
+    { "External Temperature", SensorUnit::Celsius },
+};
+static_assert(std::size(SENSOR_INFO) == static_cast<size_t>(SensorKind::Count), "one SENSOR_INFO row per SensorKind");
+
 struct AnalogSensor {
-    std::string name;
+    SensorKind kind   = SensorKind::MasterBattery;
     float voltage     = 0.0f;
     float measurement = 0.0f;
-    std::string unit;
     bool isValid      = false;
+
+    constexpr std::string_view name() const { return SENSOR_INFO[static_cast<size_t>(kind)].name; }
+    constexpr SensorUnit unit() const { return SENSOR_INFO[static_cast<size_t>(kind)].unit; }
+    std::string unitString() const;
 };
 
 struct ModemInfo {
     uint16_t currentCode   = 0;  // full 16-bit current code  — TX[33]<<8 | TX[42]
     uint16_t previousCode  = 0;  // full 16-bit previous code — TX[43]<<8 | TX[44]
     uint16_t i2cModemCode  = 0;  // per-record modem code from SEEPROM I2C block [14..15]
-    std::string currentDesc;
-    std::string previousDesc;
+    uint8_t  txSuccessCount = 0; // v4.1 only — cumulative TX success count
+
+    // Rendered from the status table on demand (Decoder::getModemStatusDescription)
+    std::string currentDesc() const;
+    std::string previousDesc() const;
 };
 
+// v4.1 frames only — replaced by the datalink byte in v4.2
+struct FlightStatus {
+    uint8_t raw       = 0;
+    bool btRxSuccess  = false;
+    bool btRxFailure  = false;
+    bool balloonBurst = false;
+    bool ascent       = false;
+    bool descent      = false;
+    bool landing      = false;
+
+    static FlightStatus fromRaw(uint8_t bits) {
+        FlightStatus f;
+        f.raw          = bits;
+        f.btRxSuccess  = bits & 0x01;
+        f.btRxFailure  = bits & 0x02;
+        f.balloonBurst = bits & 0x04;
+        f.ascent       = bits & 0x08;
+        f.descent      = bits & 0x10;
+        f.landing      = bits & 0x20;
+        return f;
+    }
+
+    constexpr std::string_view getPhaseString() const {
+        if (landing) return "LANDED";
+        if (descent || balloonBurst) return "DESCENT";
+        if (ascent) return "ASCENT";
+        return "PRE-LAUNCH";
+    }
+};
+
+// Bits set in PayloadData::gnssFaults when a GNSS sanity check fails
+namespace GnssFault {
+    constexpr uint16_t UTC_HOURS      = 1 << 0;
+    constexpr uint16_t UTC_MINUTES    = 1 << 1;
+    constexpr uint16_t UTC_SECONDS    = 1 << 2;
+    constexpr uint16_t LAT_DEGREES    = 1 << 3;
+    constexpr uint16_t LAT_MINUTES    = 1 << 4;
+    constexpr uint16_t LAT_SECONDS    = 1 << 5;
+    constexpr uint16_t LON_DEGREES    = 1 << 6;
+    constexpr uint16_t LON_MINUTES    = 1 << 7;
+    constexpr uint16_t LON_SECONDS    = 1 << 8;
+    constexpr uint16_t LAT_HEMISPHERE = 1 << 9;
+    constexpr uint16_t LON_HEMISPHERE = 1 << 10;
+    constexpr uint16_t ALT_UNITS      = 1 << 11;
+    constexpr uint16_t ALT_RANGE      = 1 << 12;
+    constexpr uint16_t NO_LOCK        = 1 << 13;
+}
+
+enum class AltitudeUnit : uint8_t {
+    Meters,
+    Feet
+};
+
+constexpr std::string_view altitudeUnitName(AltitudeUnit unit) {
+    return unit == AltitudeUnit::Feet ? "feet" : "meters";
+}
+
 struct DMS {
     uint8_t degrees = 0;
     uint8_t minutes = 0;
     uint8_t seconds = 0;
     char hemisphere = 'N';
+    uint8_t hemisphereByte = 0;  // raw, 0 or 1 when sane
 };
 
+// Plain data only: decoding allocates nothing and a payload can be
+// memcpy'd into archives or across processes. Text (units, modem
+// descriptions, ...) is rendered from enums and codes when needed.
 struct PayloadData {
     bool isValid = false;
+    TxLayoutVersion layout = TxLayoutVersion::V4_2_4;
 
     // Manufacturer header
-    std::string header;
+    std::array<char, 2> header{};   // 'R' 'B'
     bool headerValid      = false;
     uint32_t serialNumber = 0;
 
-    // Datalink status (TX[0] / I2C[12])
+    // Datalink status (TX[0] / I2C[12]) — v4.2.4
     uint8_t datalinkByte = 1;  // 0=good BT link, 1=bad BT link
     bool    btLinkGood   = false;
 
+    // Flight status + record sequence — v4.1
+    FlightStatus flightStatus;
+    uint8_t recordSequence = 0;
+
     // GNSS
     bool gnssValid     = false;
+    uint16_t gnssFaults = 0;   // GnssFault bits
     uint8_t utcHours   = 0;
     uint8_t utcMinutes = 0;
     uint8_t utcSeconds = 0;
@@ -218,7 +219,8 @@ struct PayloadData {
     double latitude  = 0.0;
     double longitude = 0.0;
     int32_t altitude = 0;
-    std::string altitudeUnits = "meters";
+    AltitudeUnit altitudeUnits = AltitudeUnit::Meters;
+    uint8_t altitudeUnitsByte  = 0;  // raw, 0 or 1 when sane
 
     // I2C sensors
     AHT20Data aht20;
@@ -233,9 +235,12 @@ struct PayloadData {
     // Modem
     ModemInfo modem;
 
+    std::string_view headerText() const { return { header.data(), header.size() }; }
     std::string toString() const;
 };
 
+static_assert(std::is_trivially_copyable_v<PayloadData>, "PayloadData must stay plain data");
+
 struct EmailContent {
     bool isValid = false;
     std::string imei;
@@ -251,18 +256,49 @@ struct EmailContent {
     std::string toString() const;
 };
 
+// One received frame (5 manufacturer bytes + 45 TX bytes), as stored in
+// archives and handed to Decoder::decodeBatch.
+using FrameBytes = std::array<uint8_t, 50>;
+
+// Frames from MOMSN firstMomsn..lastMomsn of a modem were sent with the
+// given TX array revision. Lets one process decode archives that span
+// several flight campaigns.
+struct LayoutRange {
+    std::string imei;   // empty = any modem
+    int firstMomsn = 0;
+    int lastMomsn  = 0;
+    TxLayoutVersion version = TxLayoutVersion::V4_2_4;
+};
+
 class Decoder {
 public:
-    EmailContent parseEmail(const std::string& bodyText);
-    PayloadData decodeHexPayload(const std::string& hexString);
+    EmailContent parseEmail(std::string_view bodyText);
+    // RockBLOCK direct delivery: application/x-www-form-urlencoded POST body
+    // with imei, momsn, transmit_time, iridium_latitude/longitude/cep and data
+    EmailContent parseRockBlockForm(std::string_view formBody);
+    PayloadData decodeHexPayload(const std::string& hexString,
+                                 TxLayoutVersion version = TxLayoutVersion::Auto);
+    PayloadData decodeFrame(std::span<const uint8_t> frame,
+                            TxLayoutVersion version = TxLayoutVersion::Auto);
+
+    // Decodes every frame into the matching slot of out (out.size() >= frames.size())
+    // without per-frame logging, split across up to `threads` workers
+    // (0 = one per core). Returns the number of valid payloads.
+    size_t decodeBatch(std::span<const FrameBytes> frames, std::span<PayloadData> out,
+                       TxLayoutVersion version = TxLayoutVersion::Auto, unsigned threads = 0);
+
+    void setLayoutSchedule(std::vector<LayoutRange> schedule);
+    TxLayoutVersion layoutFor(const std::string& imei, int momsn) const;
 
     static AnalogSensor decodeMasterBattery(uint16_t rawADC);
-    static AnalogSensor decodeSlaveBattery(uint8_t msb, uint8_t lsb);
+    static AnalogSensor decodeSlaveBattery(uint16_t rawADC);
     static AnalogSensor decodeInternalTemp(uint16_t rawADC);
     static AnalogSensor decodeExternalTemp(uint16_t rawADC);
+    // Table text for a known code, empty otherwise
+    static std::string_view modemStatusText(uint16_t code);
+    // Table text, or the code range plus the number for codes not in the table
     static std::string getModemStatusDescription(uint16_t code);
 
 private:
-    std::string extractField(const std::string& text, const std::string& fieldName);
-    std::vector<uint8_t> hexStringToBytes(const std::string& hex);
+    std::vector<LayoutRange> layoutSchedule_;
 };
\ No newline at end of file
@@ -0,0 +1,284 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// ============================================================
+//   FRAME LAYOUT DESCRIPTORS
+// ============================================================
+//   A frame layout is a table of Field<Member, Offset, Width, Endian>
+//   entries, one per field of the frame. Layout<> checks the table at
+//   compile time (no overlaps, nothing past the end of the frame) and
+//   generates decode() from it: one unrolled load per field into a
+//   plain raw struct, no per-field runtime bookkeeping.
+//
+//   Scaling/calibration of the raw values is done by the Decoder.
+// ============================================================
+
+namespace FrameLayout {
+
+enum class Endian : uint8_t { Big, Little };
+
+template <auto Member, size_t Offset, size_t Width = 1, Endian Order = Endian::Big>
+struct Field {
+    static constexpr size_t offset = Offset;
+    static constexpr size_t width  = Width;
+    static_assert(Width >= 1 && Width <= 4, "Field width must be 1..4 bytes");
+
+    template <typename Raw>
+    static constexpr void load(const uint8_t* b, Raw& raw) {
+        using T = std::remove_reference_t<decltype(raw.*Member)>;
+        static_assert(std::is_integral_v<T> && sizeof(T) >= Width, "Field wider than its target member");
+        uint32_t v = 0;
+        if constexpr (Order == Endian::Big) {
+            for (size_t i = 0; i < Width; ++i) v = (v << 8) | b[Offset + i];
+        } else {
+            for (size_t i = 0; i < Width; ++i) v |= static_cast<uint32_t>(b[Offset + i]) << (8 * i);
+        }
+        raw.*Member = static_cast<T>(v);
+    }
+};
+
+template <size_t Size, typename... Fields>
+constexpr bool fieldsInRange() {
+    return ((Fields::offset + Fields::width <= Size) && ...);
+}
+
+template <typename... Fields>
+constexpr bool fieldsDisjoint() {
+    constexpr size_t n = sizeof...(Fields);
+    constexpr std::array<size_t, n> off = { Fields::offset... };
+    constexpr std::array<size_t, n> wid = { Fields::width... };
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            if (off[i] < off[j] + wid[j] && off[j] < off[i] + wid[i]) return false;
+        }
+    }
+    return true;
+}
+
+template <typename Raw, size_t Size, typename... Fields>
+struct Layout {
+    using RawFrame = Raw;
+    static constexpr size_t size = Size;
+
+    static_assert(std::is_trivially_copyable_v<Raw>, "Raw frame must be trivially copyable");
+    static_assert(fieldsInRange<Size, Fields...>(), "Field extends past the end of the frame");
+    static_assert(fieldsDisjoint<Fields...>(), "Two fields overlap in the frame layout");
+
+    // b must point at (at least) Size bytes
+    static constexpr Raw decode(const uint8_t* b) {
+        Raw raw{};
+        (Fields::load(b, raw), ...);
+        return raw;
+    }
+};
+
+}
+
+// Every TX array revision the decoder knows about. Frames carry no version
+// byte, so the caller picks one (see FrameRegistry) or lets the frame size
+// choose the default.
+enum class TxLayoutVersion : uint8_t {
+    V4_1,      // flight-status frame used through the March 2026 ground tests
+    V4_2_4,    // datalink frame (current)
+    Count,
+    Auto = 0xFF
+};
+
+// ============================================================
+//   RECEIVED HEX PAYLOAD — 50 bytes total
+// ============================================================
+//   [0..1]   "RB" header         (modem manufacturer)
+//   [2..4]   Serial number       (modem manufacturer, 3 bytes big-endian)
+//   [5..49]  TX array            (our 45 bytes from buildIridiumTxArray)
+//
+//   TX ARRAY v4.2.4 layout at offset +5:
+//   [5]      Datalink byte  (0=good BT link, 1=bad BT link)
+//   [6..21]  GNSS from BT slave (lastValidBtRx[0..15])
+//              [6]  UTC Hours   [7]  UTC Min    [8]  UTC Sec
+//              [9]  Lat°  [10] Lat'  [11] Lat"  [12] Lat hemi (0=N 1=S)
+//              [13] Lon°  [14] Lon'  [15] Lon"  [16] Lon hemi (0=E 1=W)
+//              [17..20] Altitude (4-byte big-endian)
+//              [21] Altitude units (0=m 1=ft)
+//   [22..37] I2C sensor block (latestI2Cblock[0..15])
+//              [22] Radio sweep count (0-255 wrapping)
+//              [23..25] AHT20 Hum  (20-bit raw)
+//              [26..28] AHT20 Temp (20-bit raw)
+//              [29] AHT20 status (2=OK 3=fail 4=timeout)
+//              [30..31] Radio current station idx (MSB/LSB)
+//              [32] Radio current signal (0-15)
+//              [33] Radio stereo flag (1=stereo 0=mono)
+//              [34] Datalink byte copy (mirrors TX[5])
+//              [35] Radio peak signal this sweep (0-15)
+//              [36..37] Last modem return code (MSB/LSB, MODEM 2.0)
+//   [38]     Current modem return code  (high byte, TX[33])
+//   [39..40] Master battery ADC (MSB/LSB) — analogRead(29) on RP2040
+//   [41..42] Internal temp ADC  (MSB/LSB) — fdr.ADCread(port 4)
+//   [43..44] External temp ADC  (MSB/LSB) — fdr.ADCread(port 3)
+//   [45..46] Slave battery ADC  (MSB/LSB) — slave fdr.ADCread(7) via BT
+//   [47]     Current modem return code  (low byte, TX[42])
+//   [48..49] Previous modem return code (MSB/LSB, TX[43..44])
+// ============================================================
+
+struct RawFrameV424 {
+    uint16_t header        = 0;  // 'R' 'B'
+    uint32_t serialNumber  = 0;
+    uint8_t  datalinkByte  = 0;
+
+    // GNSS
+    uint8_t  utcHours      = 0;
+    uint8_t  utcMinutes    = 0;
+    uint8_t  utcSeconds    = 0;
+    uint8_t  latDegrees    = 0;
+    uint8_t  latMinutes    = 0;
+    uint8_t  latSeconds    = 0;
+    uint8_t  latHemisphere = 0;
+    uint8_t  lonDegrees    = 0;
+    uint8_t  lonMinutes    = 0;
+    uint8_t  lonSeconds    = 0;
+    uint8_t  lonHemisphere = 0;
+    uint32_t altitude      = 0;
+    uint8_t  altitudeUnits = 0;
+
+    // I2C block
+    uint8_t  radioSweepCount = 0;
+    uint32_t aht20Humidity   = 0;
+    uint32_t aht20Temp       = 0;
+    uint8_t  aht20Status     = 0;
+    uint16_t radioStation    = 0;
+    uint8_t  radioSignal     = 0;
+    uint8_t  radioStereo     = 0;
+    uint8_t  i2cDatalink     = 0;
+    uint8_t  radioPeakSignal = 0;
+    uint16_t i2cModemCode    = 0;
+
+    // Analog + modem
+    uint8_t  modemCurrentMsb   = 0;
+    uint16_t masterBattery     = 0;
+    uint16_t internalTemp      = 0;
+    uint16_t externalTemp      = 0;
+    uint16_t slaveBattery      = 0;
+    uint8_t  modemCurrentLsb   = 0;
+    uint16_t modemPreviousCode = 0;
+};
+
+using TxLayoutV424 = FrameLayout::Layout<RawFrameV424, 50,
+    FrameLayout::Field<&RawFrameV424::header,            0, 2>,
+    FrameLayout::Field<&RawFrameV424::serialNumber,      2, 3>,
+    FrameLayout::Field<&RawFrameV424::datalinkByte,      5>,
+    FrameLayout::Field<&RawFrameV424::utcHours,          6>,
+    FrameLayout::Field<&RawFrameV424::utcMinutes,        7>,
+    FrameLayout::Field<&RawFrameV424::utcSeconds,        8>,
+    FrameLayout::Field<&RawFrameV424::latDegrees,        9>,
+    FrameLayout::Field<&RawFrameV424::latMinutes,       10>,
+    FrameLayout::Field<&RawFrameV424::latSeconds,       11>,
+    FrameLayout::Field<&RawFrameV424::latHemisphere,    12>,
+    FrameLayout::Field<&RawFrameV424::lonDegrees,       13>,
+    FrameLayout::Field<&RawFrameV424::lonMinutes,       14>,
+    FrameLayout::Field<&RawFrameV424::lonSeconds,       15>,
+    FrameLayout::Field<&RawFrameV424::lonHemisphere,    16>,
+    FrameLayout::Field<&RawFrameV424::altitude,         17, 4>,
+    FrameLayout::Field<&RawFrameV424::altitudeUnits,    21>,
+    FrameLayout::Field<&RawFrameV424::radioSweepCount,  22>,
+    FrameLayout::Field<&RawFrameV424::aht20Humidity,    23, 3>,
+    FrameLayout::Field<&RawFrameV424::aht20Temp,        26, 3>,
+    FrameLayout::Field<&RawFrameV424::aht20Status,      29>,
+    FrameLayout::Field<&RawFrameV424::radioStation,     30, 2>,
+    FrameLayout::Field<&RawFrameV424::radioSignal,      32>,
+    FrameLayout::Field<&RawFrameV424::radioStereo,      33>,
+    FrameLayout::Field<&RawFrameV424::i2cDatalink,      34>,
+    FrameLayout::Field<&RawFrameV424::radioPeakSignal,  35>,
+    FrameLayout::Field<&RawFrameV424::i2cModemCode,     36, 2>,
+    FrameLayout::Field<&RawFrameV424::modemCurrentMsb,  38>,
+    FrameLayout::Field<&RawFrameV424::masterBattery,    39, 2>,
+    FrameLayout::Field<&RawFrameV424::internalTemp,     41, 2>,
+    FrameLayout::Field<&RawFrameV424::externalTemp,     43, 2>,
+    FrameLayout::Field<&RawFrameV424::slaveBattery,     45, 2>,
+    FrameLayout::Field<&RawFrameV424::modemCurrentLsb,  47>,
+    FrameLayout::Field<&RawFrameV424::modemPreviousCode, 48, 2>
+>;
+
+// ============================================================
+//   TX ARRAY v4.1 (legacy) — 50 bytes, same manufacturer prefix
+// ============================================================
+//   Differences from v4.2.4:
+//   [5]      Flight status bits (bit0 BT RX ok, bit1 BT RX fail,
+//            bit2 balloon burst, bit3 ascent, bit4 descent, bit5 landed)
+//   [22]     Record sequence number (instead of radio sweep count)
+//   [34]     Flight status copy, [35..38] reserved (0x00)
+//   [45..46] Slave battery, scaled with the FDR ADC constant
+//   [47]     Current modem return code  (8-bit)
+//   [48]     Previous modem return code (8-bit)
+//   [49]     Cumulative TX success count
+// ============================================================
+
+struct RawFrameV41 {
+    uint16_t header        = 0;
+    uint32_t serialNumber  = 0;
+    uint8_t  flightStatus  = 0;
+
+    uint8_t  utcHours      = 0;
+    uint8_t  utcMinutes    = 0;
+    uint8_t  utcSeconds    = 0;
+    uint8_t  latDegrees    = 0;
+    uint8_t  latMinutes    = 0;
+    uint8_t  latSeconds    = 0;
+    uint8_t  latHemisphere = 0;
+    uint8_t  lonDegrees    = 0;
+    uint8_t  lonMinutes    = 0;
+    uint8_t  lonSeconds    = 0;
+    uint8_t  lonHemisphere = 0;
+    uint32_t altitude      = 0;
+    uint8_t  altitudeUnits = 0;
+
+    uint8_t  recordSequence = 0;
+    uint32_t aht20Humidity  = 0;
+    uint32_t aht20Temp      = 0;
+    uint8_t  aht20Status    = 0;
+    uint16_t radioStation   = 0;
+    uint8_t  radioSignal    = 0;
+    uint8_t  radioStereo    = 0;
+
+    uint16_t masterBattery  = 0;
+    uint16_t internalTemp   = 0;
+    uint16_t externalTemp   = 0;
+    uint16_t slaveBattery   = 0;
+    uint8_t  modemCurrent   = 0;
+    uint8_t  modemPrevious  = 0;
+    uint8_t  txSuccessCount = 0;
+};
+
+using TxLayoutV41 = FrameLayout::Layout<RawFrameV41, 50,
+    FrameLayout::Field<&RawFrameV41::header,          0, 2>,
+    FrameLayout::Field<&RawFrameV41::serialNumber,    2, 3>,
+    FrameLayout::Field<&RawFrameV41::flightStatus,    5>,
+    FrameLayout::Field<&RawFrameV41::utcHours,        6>,
+    FrameLayout::Field<&RawFrameV41::utcMinutes,      7>,
+    FrameLayout::Field<&RawFrameV41::utcSeconds,      8>,
+    FrameLayout::Field<&RawFrameV41::latDegrees,      9>,
+    FrameLayout::Field<&RawFrameV41::latMinutes,     10>,
+    FrameLayout::Field<&RawFrameV41::latSeconds,     11>,
+    FrameLayout::Field<&RawFrameV41::latHemisphere,  12>,
+    FrameLayout::Field<&RawFrameV41::lonDegrees,     13>,
+    FrameLayout::Field<&RawFrameV41::lonMinutes,     14>,
+    FrameLayout::Field<&RawFrameV41::lonSeconds,     15>,
+    FrameLayout::Field<&RawFrameV41::lonHemisphere,  16>,
+    FrameLayout::Field<&RawFrameV41::altitude,       17, 4>,
+    FrameLayout::Field<&RawFrameV41::altitudeUnits,  21>,
+    FrameLayout::Field<&RawFrameV41::recordSequence, 22>,
+    FrameLayout::Field<&RawFrameV41::aht20Humidity,  23, 3>,
+    FrameLayout::Field<&RawFrameV41::aht20Temp,      26, 3>,
+    FrameLayout::Field<&RawFrameV41::aht20Status,    29>,
+    FrameLayout::Field<&RawFrameV41::radioStation,   30, 2>,
+    FrameLayout::Field<&RawFrameV41::radioSignal,    32>,
+    FrameLayout::Field<&RawFrameV41::radioStereo,    33>,
+    FrameLayout::Field<&RawFrameV41::masterBattery,  39, 2>,
+    FrameLayout::Field<&RawFrameV41::internalTemp,   41, 2>,
+    FrameLayout::Field<&RawFrameV41::externalTemp,   43, 2>,
+    FrameLayout::Field<&RawFrameV41::slaveBattery,   45, 2>,
+    FrameLayout::Field<&RawFrameV41::modemCurrent,   47>,
+    FrameLayout::Field<&RawFrameV41::modemPrevious,  48>,
+    FrameLayout::Field<&RawFrameV41::txSuccessCount, 49>
+>;
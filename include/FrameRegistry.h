@@ -0,0 +1,37 @@
+#pragma once
+#include "Decoder.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// ============================================================
+//   FRAME DECODER REGISTRY
+// ============================================================
+//   One entry per (TX array revision, frame length). Each entry
+//   projects the raw frame into PayloadData its own way, so frames
+//   from different flight campaigns can be mixed in one stream.
+//
+//   Lookups are table indexed — no searching per frame:
+//     find(version, size)  exact revision (from the layout schedule)
+//     forSize(size)        newest revision for frames of that size
+// ============================================================
+
+namespace FrameRegistry {
+
+constexpr size_t MAX_FRAME_SIZE = 50;
+
+struct Entry {
+    TxLayoutVersion version;
+    size_t size;
+    const char* name;
+    void (*project)(const uint8_t* frame, PayloadData& out);
+};
+
+const Entry* find(TxLayoutVersion version, size_t size);
+const Entry* forSize(size_t size);
+const Entry* forVersion(TxLayoutVersion version);
+
+const char* versionName(TxLayoutVersion version);
+bool parseVersion(std::string_view name, TxLayoutVersion& out);
+
+}
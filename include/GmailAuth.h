@@ -1,6 +1,8 @@
 #ifndef GMAIL_AUTH_H
 #define GMAIL_AUTH_H
 #include <string>
+#include <memory>
+#include "HttpSession.h"
 /*
 Google Authentication Flow (As far as i understand it). 
 1.) First step is to acquire a client secret json file from google cloud console. So you have to create Oauth2 Credentials.
@@ -17,12 +19,12 @@ Google Authentication Flow (As far as i understand it).
 */
 class GmailAuth {
     public:
-        GmailAuth(const std::string clientSecretFile, const std::string tokenCache); //Every GmailAuth Method Needs a CLient Secret File Location and a Token Cache Location
+        GmailAuth(const std::string clientSecretFile, const std::string tokenCache, std::shared_ptr<HttpSession> session, const std::string tokenUrl); //Every GmailAuth Method Needs a CLient Secret File Location and a Token Cache Location, plus the shared HTTP session and token endpoint
         bool authenticate(); // This is the Method that handles the entire authentication flow. Its the Highest level of the class.
         const std::string getAccessToken(); // Gets access token
-        const bool isAuthenticated(); // For a user to be authenticated they need to have a token and it has to not be expired // Getter Method
+        bool isAuthenticated(); // For a user to be authenticated they need to have a token and it has to not be expired // Getter Method
         bool refreshToken(); // Returns true of refresh token exists
-        const bool isTokenExpired(); // Getter Method
+        bool isTokenExpired(); // Getter Method
     private:
         std::string clientId; // stores client ID
         std::string clientSecret; // stores client secret filepath
@@ -32,6 +34,8 @@ class GmailAuth {
         time_t tokenExpiry; //stores the time left for token
         std::string clientSecretFile; // Store client secret file path
         std::string tokenCacheFile; // Stores token cache file path
+        std::string tokenUrl; // token endpoint, overridable for a local test server
+        std::shared_ptr<HttpSession> session; // shared with GmailClient so connections are reused
         bool loadClientSecret();
         std::string getAuthorizationCode();
         bool exchangeCodeForTokens(const std::string& code); // This is really only used once initially, the code needs to be copy and pasted by a user. not sure how to automate this.
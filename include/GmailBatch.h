@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ============================================================
+//   GMAIL BATCH ENDPOINT — multipart/mixed framing
+// ============================================================
+//   POST <batchUrl> with Content-Type: multipart/mixed; each part is an
+//   application/http "GET <path>/messages/<id>?format=full". The outer
+//   Authorization header applies to every inner request. The reply is
+//   multipart/mixed with one embedded HTTP response per part, matched
+//   back by Content-ID (<response-itemN>), in any order.
+// ============================================================
+
+namespace GmailBatch {
+
+// Boundary of the requests buildBody() writes
+extern const std::string BOUNDARY;
+
+struct Item {
+    size_t index = 0;          // position within the batch (from Content-ID)
+    int status = 0;            // embedded HTTP status, 0 if there was none
+    std::string_view body;     // points into the reply passed to demux()
+};
+
+// Path part of the API base URL, e.g. "/gmail/v1/users/me"
+std::string urlPath(const std::string& url);
+
+// Request body for ids[first, first + count), part i has Content-ID <itemi>
+std::string buildBody(const std::string& apiPath, const std::vector<std::string>& ids,
+                      size_t first, size_t count);
+
+// boundary parameter of a multipart Content-Type, unquoted; "" if absent
+std::string boundaryFrom(std::string_view contentType);
+
+// Splits a batch reply into items. Returns false if the envelope itself
+// is malformed (no boundary, no closing delimiter); failed requests come
+// back as items with their status.
+bool demux(std::string_view contentType, std::string_view body, std::vector<Item>& items);
+
+}
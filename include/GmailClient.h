@@ -3,34 +3,81 @@
 #ifndef GMAIL_CLIENT_H
 #define GMAIL_CLIENT_H
 #include "GmailAuth.h"
+#include "HttpSession.h"
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <unordered_map>
 
 // Stucture of the Gmail Message Object
+// The strings live in the memory resource the message was built with. For
+// messages returned by GmailClient that is the calling thread's
+// ScratchArena, valid until its next reset(). A copy goes to the heap and
+// can be kept longer.
 struct GmailMessage {
-    std::string id;
-    std::string threadId;
-    std::string subject;
-    std::string from;
-    std::string to;
-    std::string date;
-    std::string snippet;     
-    std::string bodyText; // Body Text is where the data is located
-    std::string bodyHtml;     
+    GmailMessage() = default;
+    explicit GmailMessage(std::pmr::memory_resource* resource)
+        : id(resource), threadId(resource), subject(resource), from(resource), to(resource),
+          date(resource), snippet(resource), bodyText(resource), bodyHtml(resource) {}
+
+    std::pmr::string id;
+    std::pmr::string threadId;
+    std::pmr::string subject;
+    std::pmr::string from;
+    std::pmr::string to;
+    std::pmr::string date;
+    std::pmr::string snippet;
+    std::pmr::string bodyText; // Body Text is where the data is located
+    std::pmr::string bodyHtml;
 };
 class GmailClient {
     public:
-        explicit GmailClient(std::shared_ptr<GmailAuth> auth);
+        GmailClient(std::shared_ptr<GmailAuth> auth, std::shared_ptr<HttpSession> session, const std::string& baseUrl);
         ~GmailClient();
         std::vector<GmailMessage> getMessageAfter(time_t afterTime, const std::string& senderEmail= "");
+        // Messages added since the last poll: History API delta when history sync is
+        // enabled, otherwise the after: search. afterTime is the search fallback.
+        // Like getMessageAfter, the messages are built in ScratchArena::forThread().
+        std::vector<GmailMessage> getNewMessages(time_t afterTime, const std::string& senderEmail = "");
+        void enableHistorySync(const std::string& checkpointPath); // loads the persisted historyId
+        void setMaxConcurrentFetches(size_t limit); // requests in flight while fetching message bodies
+        void setBatch(const std::string& batchUrl, size_t batchSize); // batchSize 0 = no batch endpoint
+        static int momsnFromSubject(std::string_view subject);
+        // messages.get (format=full) JSON -> GmailMessage with decoded bodies, built
+        // in `resource` along with the parser's working strings; no network
+        static GmailMessage parseResponse(std::string_view jsonResponse,
+                                          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        static std::string decodeBase64Url(const std::string& encoded);
     private:
+        // Outcome of fetching one message ID. Gone (404/410: deleted or moved
+        // since it was listed) counts as done; Failed (transport error, other
+        // HTTP status, unparseable body) is worth asking for again.
+        enum class FetchStatus : uint8_t { Ok, Gone, Failed };
+        static constexpr int MAX_FETCH_ATTEMPTS = 5; // polls a Failed ID may hold the history checkpoint
+
         std::shared_ptr<GmailAuth> auth_;
+        std::shared_ptr<HttpSession> session_;
         std::string baseUrl_;
+        size_t maxConcurrentFetches_ = 8;
+        std::string batchUrl_;
+        size_t batchSize_ = 50;
+        std::string checkpointPath_; // empty = history sync off
+        std::string historyId_;
+        std::unordered_map<std::string, int> fetchAttempts_; // Failed polls per message ID
+        bool ensureToken();
+        bool seedHistoryId();
+        bool saveCheckpoint();
+        // status[i] is the outcome for ids[i]; the messages are in MOMSN order
+        std::vector<GmailMessage> fetchAll(const std::vector<std::string>& ids, std::vector<FetchStatus>& status);
+        std::vector<GmailMessage> fetchMessages(const std::vector<std::string>& ids, std::vector<FetchStatus>& status);
+        std::vector<GmailMessage> fetchMessagesBatched(const std::vector<std::string>& ids, std::vector<FetchStatus>& status);
+        static FetchStatus statusFor(const std::string& messageId, long httpCode);
+        static void sortByMomsn(std::vector<GmailMessage>& messages);
+        HttpResponse apiGet(const std::string& endpoint);
         std::string makeGetRequest(const std::string& endpoint);
-        GmailMessage getMessageById(const std::string& messageId);
-        GmailMessage parseResponse(const std::string& jsonResponse);
-        std::string decodeBase64Url(const std::string& encoded);
-        std::string extractBodyFromParts(const std::string& parts, const std::string& mimeType);
+        GmailMessage getMessageById(const std::string& messageId, FetchStatus& status);
 };
 #endif 
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// ============================================================
+//   HEX -> BYTES
+// ============================================================
+//   Decodes the ASCII hex "Data:" field of a RockBLOCK message
+//   into a caller-provided buffer. Nothing is allocated.
+//
+//   - Upper and lower case digits are accepted.
+//   - ASCII whitespace between digits is skipped (wrapped mail lines).
+//   - Any other character stops the decode and is reported by position.
+//   - Runs of clean digits go through an SSE2 (or AVX2 when the CPU
+//     has it) block decoder; everything else uses a 256-entry table.
+// ============================================================
+
+namespace HexCodec {
+
+enum class Status : uint8_t {
+    Ok,
+    InvalidChar,  // errorPos = offset of the offending character
+    OddDigits,    // errorPos = offset of the unpaired last digit
+    Overflow      // errorPos = offset of the first digit that did not fit
+};
+
+struct Result {
+    Status status       = Status::Ok;
+    size_t bytesWritten = 0;
+    size_t errorPos     = 0;
+
+    bool ok() const { return status == Status::Ok; }
+};
+
+// Block decoders decode() may use. It picks the best one the CPU has;
+// a lower level is for differential tests and benchmarks. Levels the
+// CPU lacks fall back to the best it has.
+enum class Simd : uint8_t { None, Sse2, Avx2 };
+Simd bestSimd();
+
+Result decode(std::string_view hex, std::span<uint8_t> out);
+Result decode(std::string_view hex, std::span<uint8_t> out, Simd simd);
+
+const char* statusString(Status status);
+
+}
@@ -0,0 +1,106 @@
+#ifndef HTTP_SERVER_H
+#define HTTP_SERVER_H
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// ============================================================
+//   EMBEDDED HTTP SERVER
+// ============================================================
+//   Minimal HTTP/1.1 listener on POSIX sockets for webhooks and the
+//   dashboard. One accept thread plus one short-lived thread per
+//   connection; keep-alive is honoured. Requests need a Content-Length
+//   body (no chunked uploads) of at most MAX_BODY_BYTES.
+//
+//   Handlers run on connection threads and must be thread-safe.
+//   Stream routes (Server-Sent Events) keep their connection thread
+//   for as long as the client stays connected.
+// ============================================================
+
+struct HttpRequest {
+    std::string method;
+    std::string path;      // without the query string
+    std::string query;     // raw, after '?'
+    std::vector<std::pair<std::string, std::string>> headers;  // names lower-cased
+    std::string body;
+
+    std::string_view header(std::string_view name) const;      // name in lower case
+    std::string queryParam(std::string_view name) const;       // URL-decoded, "" if absent
+};
+
+struct HttpReply {
+    int status = 200;
+    std::string contentType = "text/plain; charset=utf-8";
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string body;
+};
+
+// Open text/event-stream response handed to a stream handler
+class HttpStream {
+    public:
+        // False once the client went away; the handler should return then
+        bool send(std::string_view data);
+        // False when the server is stopping
+        bool active() const;
+
+    private:
+        friend class HttpServer;
+        HttpStream(int fd, const std::atomic<bool>& running) : fd_(fd), running_(running) {}
+
+        int fd_;
+        const std::atomic<bool>& running_;
+        bool failed_ = false;
+};
+
+class HttpServer {
+    public:
+        using Handler = std::function<HttpReply(const HttpRequest&)>;
+        using StreamHandler = std::function<void(const HttpRequest&, HttpStream&)>;
+
+        static constexpr size_t MAX_BODY_BYTES = 1 << 20;
+
+        HttpServer() = default;
+        ~HttpServer();
+        HttpServer(const HttpServer&) = delete;
+        HttpServer& operator=(const HttpServer&) = delete;
+
+        // Exact path match; register before start()
+        void route(const std::string& method, const std::string& path, Handler handler);
+        // GET route answered with text/event-stream; the handler returns when done
+        void routeStream(const std::string& path, StreamHandler handler);
+        // Called for paths no route matches (e.g. static files), any method
+        void setFallback(Handler handler);
+
+        bool start(const std::string& bindAddress, uint16_t port);
+        void stop();
+        uint16_t port() const { return port_; }
+
+        static std::string urlDecode(std::string_view value);
+
+    private:
+        struct Route {
+            std::string method;
+            std::string path;
+            Handler handler;
+            StreamHandler stream;   // set for routeStream() routes
+        };
+
+        void acceptLoop();
+        void serveConnection(int fd);
+        HttpReply dispatch(const HttpRequest& request) const;
+        const Route* findStream(const HttpRequest& request) const;
+
+        std::vector<Route> routes_;
+        Handler fallback_;
+        int listenFd_ = -1;
+        uint16_t port_ = 0;
+        std::atomic<bool> running_{false};
+        std::atomic<int> openConnections_{0};
+        std::thread acceptThread_;
+};
+#endif
@@ -0,0 +1,63 @@
+#ifndef HTTP_SESSION_H
+#define HTTP_SESSION_H
+#include <curl/curl.h>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ============================================================
+//   HTTP SESSION — one per process, shared by GmailAuth/GmailClient
+// ============================================================
+//   Keeps a long-lived easy handle so keep-alive connections and TLS
+//   sessions survive between polls, and a CURLSH share (DNS cache, TLS
+//   session cache, connection pool) that any extra handles from
+//   newHandle() join. HTTP/2 is negotiated over TLS when the server
+//   offers it. Base URLs live in the callers, so a local HTTPS stand-in
+//   can replace Google for testing. TLS certificates and host names are
+//   verified unless the session is built with verifyTls=false, which is
+//   only meant for a stand-in with a self-signed certificate.
+// ============================================================
+
+struct HttpResponse {
+    CURLcode curlCode = CURLE_OK;
+    long status = 0;          // HTTP status, 0 if the transfer failed
+    std::string contentType;  // response Content-Type, needed for multipart boundaries
+    std::string body;
+    std::string error;        // curl error text when curlCode != CURLE_OK
+
+    bool ok() const { return curlCode == CURLE_OK && status == 200; }
+};
+
+class HttpSession {
+    public:
+        explicit HttpSession(bool verifyTls = true);
+        ~HttpSession();
+        HttpSession(const HttpSession&) = delete;
+        HttpSession& operator=(const HttpSession&) = delete;
+
+        HttpResponse get(const std::string& url, const std::vector<std::string>& headers);
+        HttpResponse post(const std::string& url, const std::string& body, const std::vector<std::string>& headers);
+
+        // New easy handle attached to the share with the session defaults
+        // (HTTP/2, keep-alive, TLS verification). Caller owns it and frees it with curl_easy_cleanup.
+        CURL* newHandle();
+        // Applies the session defaults to a handle that was curl_easy_reset()
+        void configure(CURL* handle);
+
+        std::string escape(std::string_view value);
+
+    private:
+        HttpResponse perform(const std::string& url, const std::string* postBody,
+                             const std::vector<std::string>& headers);
+
+        static void lockShare(CURL*, curl_lock_data data, curl_lock_access, void* userp);
+        static void unlockShare(CURL*, curl_lock_data data, void* userp);
+
+        bool verifyTls_ = true;
+        CURLSH* share_ = nullptr;
+        CURL* handle_ = nullptr;            // reused for every blocking request
+        std::mutex handleMutex_;
+        std::mutex shareLocks_[CURL_LOCK_DATA_LAST];
+};
+#endif
@@ -0,0 +1,38 @@
+#ifndef INGEST_EVENTS_H
+#define INGEST_EVENTS_H
+#include "Decoder.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+// ============================================================
+//   INGEST EVENTS — wakes the poll loop early
+// ============================================================
+//   Webhook handlers run on server threads and hand work to main()
+//   through here: notifyMailbox() for a Gmail push (fetch now) and
+//   pushFrame() for a frame RockBLOCK POSTed directly (already
+//   decoded, no Gmail round trip). main() waits on waitFor() instead
+//   of sleeping; the poll interval only acts as a fallback. Events
+//   that arrive while main() is busy are coalesced into the next wake.
+// ============================================================
+
+class IngestEvents {
+    public:
+        struct Wake {
+            bool timedOut = false;        // nothing arrived within the timeout
+            bool mailboxChanged = false;  // Gmail push received
+            std::vector<EmailContent> frames;
+        };
+
+        void notifyMailbox();
+        void pushFrame(EmailContent frame);
+        Wake waitFor(std::chrono::milliseconds timeout);
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool mailboxChanged_ = false;
+        std::vector<EmailContent> frames_;
+};
+#endif
@@ -0,0 +1,181 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// ============================================================
+//   LOG MESSAGE FORMATTING — "{}" placeholders, std::format style
+// ============================================================
+//   The toolchain has no <format>, so ASCEND_LOG formats through this
+//   small subset instead:
+//
+//     {}        default: integers in decimal, floats like std::to_string
+//               (6 decimals, same text the old log lines had), strings
+//               and chars as is, bool as true/false
+//     {:N}      minimum width N (right aligned, '0' prefix pads with zeros)
+//     {:.Nf}    N decimals
+//     {:x} {:X} hex, e.g. {:02X}
+//     {{ }}     literal braces
+//
+//   The number of placeholders is checked against the argument count
+//   at compile time, like std::format_string.
+// ============================================================
+
+namespace LogFormat {
+
+struct Spec {
+    bool zeroPad  = false;
+    int width     = 0;
+    int precision = -1;
+    char type     = 0;
+};
+
+consteval size_t countPlaceholders(std::string_view fmt) {
+    size_t count = 0;
+    for (size_t i = 0; i < fmt.size(); ++i) {
+        if (fmt[i] == '{') {
+            if (i + 1 < fmt.size() && fmt[i + 1] == '{') { ++i; continue; }
+            size_t close = fmt.find('}', i);
+            if (close == std::string_view::npos) throw "unterminated '{' in log format";
+            ++count;
+            i = close;
+        }
+    }
+    return count;
+}
+
+template <typename... Args>
+struct FormatString {
+    std::string_view str;
+
+    template <typename S>
+        requires std::convertible_to<const S&, std::string_view>
+    consteval FormatString(const S& s) : str(s) {
+        if (countPlaceholders(str) != sizeof...(Args)) throw "log format placeholder count does not match the arguments";
+    }
+};
+
+inline void pad(std::string& out, size_t length, const Spec& spec) {
+    if (spec.width > 0 && length < static_cast<size_t>(spec.width)) {
+        out.append(static_cast<size_t>(spec.width) - length, spec.zeroPad ? '0' : ' ');
+    }
+}
+
+inline void appendArg(std::string& out, std::string_view v, const Spec& spec) {
+    pad(out, v.size(), spec);
+    out += v;
+}
+
+inline void appendArg(std::string& out, const std::string& v, const Spec& spec) {
+    appendArg(out, std::string_view(v), spec);
+}
+
+inline void appendArg(std::string& out, const char* v, const Spec& spec) {
+    appendArg(out, std::string_view(v ? v : "(null)"), spec);
+}
+
+inline void appendArg(std::string& out, char v, const Spec& spec) {
+    appendArg(out, std::string_view(&v, 1), spec);
+}
+
+inline void appendArg(std::string& out, bool v, const Spec& spec) {
+    appendArg(out, std::string_view(v ? "true" : "false"), spec);
+}
+
+template <std::integral T>
+    requires (!std::same_as<T, bool> && !std::same_as<T, char>)
+void appendArg(std::string& out, T v, const Spec& spec) {
+    char buf[40];
+    const int base = (spec.type == 'x' || spec.type == 'X') ? 16 : 10;
+    // uint8_t prints as a number, not a character
+    auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), +v, base);
+    if (spec.type == 'X') {
+        for (char* p = buf; p != end; ++p) if (*p >= 'a' && *p <= 'f') *p -= 'a' - 'A';
+    }
+    const bool negative = std::is_signed_v<T> && buf[0] == '-';
+    const size_t length = static_cast<size_t>(end - buf);
+    if (spec.zeroPad && negative) {
+        out += '-';
+        Spec rest = spec;
+        rest.width = spec.width > 0 ? spec.width - 1 : 0;
+        pad(out, length - 1, rest);
+        out.append(buf + 1, end);
+        return;
+    }
+    pad(out, length, spec);
+    out.append(buf, end);
+}
+
+template <std::floating_point T>
+void appendArg(std::string& out, T v, const Spec& spec) {
+    char buf[64];
+    int n = std::snprintf(buf, sizeof(buf), "%.*f", spec.precision < 0 ? 6 : spec.precision, static_cast<double>(v));
+    if (n < 0) return;
+    size_t length = std::min(static_cast<size_t>(n), sizeof(buf) - 1);
+    pad(out, length, spec);
+    out.append(buf, length);
+}
+
+// Enums print as their underlying value
+template <typename T>
+    requires std::is_enum_v<T>
+void appendArg(std::string& out, T v, const Spec& spec) {
+    appendArg(out, static_cast<std::underlying_type_t<T>>(v), spec);
+}
+
+// Parses the text between ':' and '}' of a placeholder
+inline Spec parseSpec(std::string_view s) {
+    Spec spec;
+    size_t i = 0;
+    if (i < s.size() && s[i] == '0') { spec.zeroPad = true; ++i; }
+    while (i < s.size() && s[i] >= '0' && s[i] <= '9') spec.width = spec.width * 10 + (s[i++] - '0');
+    if (i < s.size() && s[i] == '.') {
+        spec.precision = 0;
+        ++i;
+        while (i < s.size() && s[i] >= '0' && s[i] <= '9') spec.precision = spec.precision * 10 + (s[i++] - '0');
+    }
+    if (i < s.size()) spec.type = s[i];
+    return spec;
+}
+
+// Copies literal text up to the next placeholder, unescaping "{{" and "}}".
+// Returns false when the format string is exhausted.
+inline bool nextPlaceholder(std::string& out, std::string_view& fmt, Spec& spec) {
+    size_t i = 0;
+    while (i < fmt.size()) {
+        char c = fmt[i];
+        if ((c == '{' || c == '}') && i + 1 < fmt.size() && fmt[i + 1] == c) {
+            out += c;
+            i += 2;
+        } else if (c == '{') {
+            size_t close = fmt.find('}', i);
+            std::string_view inner = fmt.substr(i + 1, close - i - 1);
+            size_t colon = inner.find(':');
+            spec = colon == std::string_view::npos ? Spec{} : parseSpec(inner.substr(colon + 1));
+            fmt.remove_prefix(close + 1);
+            return true;
+        } else {
+            out += c;
+            ++i;
+        }
+    }
+    fmt = {};
+    return false;
+}
+
+template <typename... Args>
+std::string format(FormatString<std::type_identity_t<Args>...> fmt, const Args&... args) {
+    std::string out;
+    out.reserve(fmt.str.size() + 16 * sizeof...(Args));
+    std::string_view rest = fmt.str;
+    Spec spec;
+    ((nextPlaceholder(out, rest, spec), appendArg(out, args, spec)), ...);
+    nextPlaceholder(out, rest, spec);
+    return out;
+}
+
+} // namespace LogFormat
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+// ============================================================
+//   SCRATCH ARENA — per-thread bump allocator for one work cycle
+// ============================================================
+//   Processing a poll's messages builds many short-lived strings:
+//   HTTP response bodies, parser state and decoded message bodies.
+//   They all die together. Those strings are std::pmr strings on a
+//   std::pmr::monotonic_buffer_resource that hands out memory from a
+//   block the arena keeps. reset() drops everything at once and
+//   rewinds to the start of the block.
+//
+//   A cycle that outgrows the block spills to the heap; the spill is
+//   counted in Stats. The next reset() then replaces the block with
+//   one large enough for that cycle, capped at MAX_BLOCK_BYTES. After
+//   the first few cycles, processing makes no heap calls through the
+//   arena at all.
+//
+//   Memory from resource() is invalid after reset(). Destroy the
+//   objects that use it first.
+// ============================================================
+
+class ScratchArena {
+public:
+    static constexpr size_t DEFAULT_BLOCK_BYTES = 64 * 1024;
+    static constexpr size_t MAX_BLOCK_BYTES     = 4 * 1024 * 1024;
+
+    struct Stats {
+        size_t blockBytes        = 0;  // block currently kept between cycles
+        uint64_t resets          = 0;
+        uint64_t heapAllocations = 0;  // spills plus block regrowth, since construction
+        uint64_t heapBytes       = 0;
+    };
+
+    explicit ScratchArena(size_t blockBytes = DEFAULT_BLOCK_BYTES);
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &*arena_; }
+    void reset();
+    Stats stats() const;
+
+    // The calling thread's arena, created on first use
+    static ScratchArena& forThread();
+
+private:
+    // Upstream of the monotonic resource: the heap, counted
+    class SpillResource : public std::pmr::memory_resource {
+    public:
+        uint64_t allocations = 0;
+        uint64_t bytes       = 0;
+        size_t cycleBytes    = 0;  // since the last reset
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    std::unique_ptr<std::byte[]> block_;
+    size_t blockBytes_;
+    uint64_t resets_ = 0;
+    SpillResource spill_;
+    std::optional<std::pmr::monotonic_buffer_resource> arena_;
+};
@@ -0,0 +1,84 @@
+#pragma once
+#include "Decoder.h"
+#include "TelemetryStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+// ============================================================
+//   TELEMETRY ARCHIVE — durable raw frames, replayed at startup
+// ============================================================
+//   Append-only file of fixed-size records: the raw 50-byte frame
+//   plus the Iridium metadata that came with it. Decoded values are
+//   not stored; replay maps the file and runs the frames through
+//   Decoder::decodeBatch, so a decoder fix applies to old frames too.
+//
+//   [ArchiveHeader 64 B][ArchiveRecord 128 B][ArchiveRecord 128 B]...
+//
+//   Every record carries a CRC32 of its other bytes; records that
+//   fail it are skipped on replay. A torn record at the tail (crash
+//   during write) is cut off when the archive is opened. Integers
+//   are stored in host byte order.
+// ============================================================
+
+struct ArchiveHeader {
+    char magic[8];          // "ASCNDARC"
+    uint32_t version;
+    uint32_t headerSize;    // sizeof(ArchiveHeader)
+    uint32_t recordSize;    // sizeof(ArchiveRecord)
+    uint32_t reserved[10];
+    uint32_t crc;           // CRC32 of the bytes before it
+};
+
+struct ArchiveRecord {
+    char imei[16];          // NUL-padded
+    int32_t momsn;
+    int32_t sessionStatus;
+    double iridiumLatitude;
+    double iridiumLongitude;
+    double iridiumCep;
+    char transmitTime[24];  // NUL-padded, "2025-03-29T19:50:12Z"
+    uint8_t frame[50];
+    uint8_t frameSize;
+    uint8_t layout;         // TxLayoutVersion the frame was decoded with
+    uint32_t crc;           // CRC32 of the bytes before it
+};
+
+static_assert(sizeof(ArchiveHeader) == 64, "archive header layout changed");
+static_assert(sizeof(ArchiveRecord) == 128, "archive record layout changed");
+static_assert(std::is_trivially_copyable_v<ArchiveRecord>, "archive records are written with memcpy");
+static_assert(sizeof(ArchiveRecord::frame) == std::tuple_size_v<FrameBytes>, "archive frame size");
+
+class TelemetryArchive {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    explicit TelemetryArchive(std::string path);
+    ~TelemetryArchive();
+    TelemetryArchive(const TelemetryArchive&) = delete;
+    TelemetryArchive& operator=(const TelemetryArchive&) = delete;
+
+    // Creates the file or validates an existing header. False (and
+    // nothing is written) if the file is not an archive of this version.
+    bool open();
+
+    // Appends one stored frame and syncs it to disk before returning.
+    // Safe to call from several threads.
+    bool append(const EmailContent& telemetry);
+
+    // Maps the archive, decodes every intact record in bulk and appends
+    // the frames not already in the store. Returns the number appended.
+    size_t replay(Decoder& decoder, TelemetryStore& store);
+
+    bool isOpen() const { return fd_ >= 0; }
+    size_t records() const { return records_; }
+
+private:
+    std::string path_;
+    int fd_ = -1;
+    size_t records_ = 0;
+    std::mutex appendMutex_;  // main loop and the RockBLOCK POST handler
+    bool misaligned_ = false; // a torn tail or failed append could not be truncated away
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include "TelemetryStore.h"
+#include <cstddef>
+#include <string>
+#include <nlohmann/json.hpp>
+
+// ============================================================
+//   INCREMENTAL TELEMETRY EXPORT (dashboard)
+// ============================================================
+//   <dir>/telemetry.ndjson          one JSON record per line, append-only
+//   <dir>/telemetry.manifest.json   { lastUpdated, totalRecords, bytes }
+//
+//   Each export appends only the records added since the last call,
+//   then publishes a new manifest by writing a temp file and renaming
+//   it over the old one. Readers trust the first `bytes` bytes of the
+//   NDJSON file, so a half-written tail line is never parsed.
+//   Nothing is written when no records were added, except to retry a
+//   failed manifest publish. A failed append is cut back off the NDJSON
+//   file so it always ends at the last published offset.
+// ============================================================
+
+class TelemetryExporter {
+public:
+    explicit TelemetryExporter(std::string directory);
+
+    // Returns true if new records were written
+    bool exportNew(const TelemetryStore& store);
+
+    static nlohmann::json rowToJson(const TelemetryStore& store, size_t i);
+
+private:
+    bool publishManifest(size_t totalRecords);
+    bool truncateToExported();
+
+    std::string ndjsonPath_;
+    std::string manifestPath_;
+    size_t exportedRecords_ = 0;
+    size_t exportedBytes_   = 0;
+    bool ndjsonDirty_   = false;  // a failed append may have left bytes past exportedBytes_
+    bool manifestDirty_ = false;  // the last manifest publish failed
+};
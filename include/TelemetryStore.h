@@ -0,0 +1,117 @@
+#pragma once
+#include "Decoder.h"
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// ============================================================
+//   TELEMETRY STORE — one contiguous column per field
+// ============================================================
+//   Replaces std::vector<EmailContent>. Record i is element i of
+//   every column, in arrival order. IMEIs are interned once in a
+//   StringPool and stored as 4-byte ids. The raw 50-byte frame is
+//   kept instead of its hex text.
+//
+//   Only the fields the dashboard plots over the whole history get a
+//   column; a pass over one of them touches only that field's memory.
+//   Everything else (radio, modem codes, voltages, ...) is projected
+//   from the frame again when a record is exported.
+// ============================================================
+
+class StringPool {
+public:
+    uint32_t intern(std::string_view s);
+    bool find(std::string_view s, uint32_t& id) const;
+    std::string_view get(uint32_t id) const { return strings_[id]; }
+    size_t size() const { return strings_.size(); }
+
+private:
+    std::deque<std::string> strings_;  // deque: views stay valid as it grows
+    std::unordered_map<std::string_view, uint32_t> ids_;
+};
+
+// Variable-length text packed back to back in one buffer (transmit times)
+class TextColumn {
+public:
+    void push_back(std::string_view s);
+    std::string_view operator[](size_t i) const;
+    size_t size() const { return ends_.size(); }
+    void reserve(size_t records, size_t bytesPerRecord);
+
+private:
+    std::string data_;
+    std::vector<uint32_t> ends_;
+};
+
+enum SensorSlot : uint8_t {
+    SENSOR_MASTER_BATTERY,
+    SENSOR_SLAVE_BATTERY,
+    SENSOR_INTERNAL_TEMP,
+    SENSOR_EXTERNAL_TEMP,
+    SENSOR_COUNT
+};
+static_assert(SENSOR_COUNT == static_cast<size_t>(SensorKind::Count), "slot i holds SensorKind i");
+
+struct TelemetryColumns {
+    // Iridium metadata (not part of the frame)
+    std::vector<int32_t>  momsn;
+    std::vector<uint32_t> imei;              // StringPool id
+    TextColumn            transmitTime;
+    std::vector<double>   iridiumLatitude;
+    std::vector<double>   iridiumLongitude;
+    std::vector<double>   iridiumCep;
+    std::vector<int32_t>  sessionStatus;
+
+    // The frame and the revision it was decoded with; any payload field
+    // without a column below is projected again from these (payload(i))
+    std::vector<FrameBytes> frame;
+    std::vector<uint8_t>  frameSize;
+    std::vector<uint8_t>  layout;            // TxLayoutVersion
+
+    // Fields the dashboard maps or charts across the whole history
+    std::vector<uint8_t>  gnssValid;
+    std::vector<double>   latitude;
+    std::vector<double>   longitude;
+    std::vector<int32_t>  altitude;
+    std::vector<uint8_t>  altitudeUnits;     // AltitudeUnit
+    std::vector<uint8_t>  btLinkGood;
+    std::vector<float>    aht20TempC;
+    std::vector<float>    aht20HumidityRH;
+    std::array<std::vector<float>, SENSOR_COUNT> sensorMeasurement;
+};
+
+class TelemetryStore {
+public:
+    void append(const EmailContent& telemetry);
+    // Same, with the frame already in binary form (telemetry.hexData is ignored)
+    void append(const EmailContent& telemetry, const FrameBytes& frame, size_t frameSize);
+    void reserve(size_t records);
+
+    size_t size() const { return cols_.momsn.size(); }
+    bool empty() const { return size() == 0; }
+
+    // True if a frame with this modem IMEI and MOMSN is already stored
+    bool contains(std::string_view imei, int momsn) const;
+
+    const TelemetryColumns& columns() const { return cols_; }
+    // Record i's full payload, projected again from its frame
+    PayloadData payload(size_t i) const;
+    std::string_view str(uint32_t id) const { return strings_.get(id); }
+
+    // Approximate heap bytes per record, for the startup log
+    size_t bytesPerRecord() const;
+
+private:
+    static uint64_t frameKey(uint32_t imeiId, int momsn) {
+        return (static_cast<uint64_t>(imeiId) << 32) | static_cast<uint32_t>(momsn);
+    }
+
+    TelemetryColumns cols_;
+    StringPool strings_;
+    std::unordered_set<uint64_t> frameKeys_;  // imei id << 32 | momsn
+};
@@ -2,7 +2,19 @@
 #define LOGGER_H
 
 #include <string>
+#include <string_view>
 #include <fstream>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <ctime>
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "LogFormat.h"
 
 enum LogLevel {
     LOG_DEBUG,
@@ -11,18 +23,100 @@ enum LogLevel {
     LOG_ERROR
 };
 
+// One line of the recent-log ring the dashboard reads. Plain data so the
+// ring is a single allocation; messages longer than MESSAGE_BYTES are cut.
+struct LogEntry {
+    static constexpr size_t MESSAGE_BYTES = 494;
+
+    uint64_t seq = 0;          // 1, 2, 3, ... across the process lifetime
+    int64_t epochTime = 0;
+    uint8_t level = 0;         // LogLevel
+    bool truncated = false;
+    uint16_t length = 0;
+    char message[MESSAGE_BYTES];
+
+    std::string_view text() const { return std::string_view(message, length); }
+};
+
+// Asynchronous logger: log() moves the message into a bounded lock-free
+// multi-producer ring and returns; one writer thread drains it in batches
+// to the log file, the console and the dashboard JSON.
 class Logger {
 private:
+    struct Record {
+        LogLevel level = LOG_INFO;
+        time_t epochTime = 0;
+        std::string message;
+    };
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        Record record;
+    };
+    static constexpr size_t RING_CAPACITY = 4096;  // power of two
+
     std::ofstream logFile;
     LogLevel minLevel;
-    std::string getTimestamp();
-    std::string getLevelString(LogLevel level);
+    std::unique_ptr<Slot[]> ring;
+    alignas(64) std::atomic<size_t> head{0};       // next slot to claim (producers)
+    alignas(64) size_t tail = 0;                   // next slot to drain (writer only)
+    std::atomic<uint32_t> wakeups{0};              // bumped by every log() call
+    std::atomic<bool> writerIdle{false};
+    std::atomic<bool> running{true};
+    std::atomic<bool> consoleOutput{true};
+    std::mutex idleMutex;                          // only taken to wake an idle writer
+    std::condition_variable idleCv;
+    std::thread writer;
+
+    // Recent logs for the dashboard: written by the writer thread,
+    // read by logsSince() from any thread
+    static constexpr size_t RECENT_CAPACITY = 500;
+    std::unique_ptr<LogEntry[]> recent;
+    uint64_t lastSeq = 0;
+    bool exportDirty = false;                      // writer thread only
+    mutable std::mutex recentMutex;
+
+    bool pop(Record& out);
+    void writerLoop();
+    void write(const Record& record);
+    void remember(const Record& record);
 
 public:
+    static std::string getTimestamp(time_t when);   // local time, "YYYY-MM-DD HH:MM:SS"
+    static std::string getLevelString(LogLevel level);
+
     Logger(const std::string filename, LogLevel level);
-    ~Logger();
-    void log(LogLevel level, const std::string message);
-    void exportLogsToJson(); // Export recent logs to JSON for dashboard
+    ~Logger();  // drains everything still queued
+    void log(LogLevel level, std::string message);
+    bool enabled(LogLevel level) const { return level >= minLevel; }
+    void setConsoleOutput(bool on) { consoleOutput.store(on, std::memory_order_relaxed); }  // file and dashboard only when off
+    void exportLogsToJson(); // Export recent logs to JSON for dashboard (writer thread)
+
+    // Recent entries with seq > afterSeq, oldest first. A gap between
+    // afterSeq and the first returned seq means entries fell out of the ring.
+    std::vector<LogEntry> logsSince(uint64_t afterSeq) const;
+    uint64_t latestSeq() const;
+    static std::string logsToJson(const std::vector<LogEntry>& entries, uint64_t latest);
+
+    // logs.json is rewritten at most this often, and only when something new was logged
+    static constexpr std::chrono::seconds EXPORT_INTERVAL{2};
 };
 
-#endif
\ No newline at end of file
+// Levels below this are compiled out of ASCEND_LOG statements entirely,
+// e.g. -DASCEND_LOG_MIN_LEVEL=LOG_WARNING for a quiet decode build.
+#ifndef ASCEND_LOG_MIN_LEVEL
+#define ASCEND_LOG_MIN_LEVEL LOG_DEBUG
+#endif
+
+// ASCEND_LOG(LOG_INFO, "Lat: {} Lon: {}", lat, lon) logs through the global
+// `logger`. The arguments are not evaluated and no string is built unless
+// the level passes both the compile-time and the runtime minimum.
+#define ASCEND_LOG(level, ...)                                              \
+    do {                                                                    \
+        if constexpr ((level) >= (ASCEND_LOG_MIN_LEVEL)) {                  \
+            if (logger.enabled(level)) {                                    \
+                logger.log((level), LogFormat::format(__VA_ARGS__));        \
+            }                                                               \
+        }                                                                   \
+    } while (0)
+
+#endif
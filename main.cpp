@@ -1,198 +1,218 @@
 #include "GmailAuth.h"
 #include "GmailClient.h"
+#include "HttpSession.h"
 #include "logger.h"
-#include "config.h"
+#include "Config.h"
 #include "Decoder.h"
+#include "FrameRegistry.h"
+#include "TelemetryStore.h"
+#include "TelemetryExporter.h"
+#include "TelemetryArchive.h"
+#include "HttpServer.h"
+#include "DashboardServer.h"
+#include "IngestEvents.h"
+#include "ScratchArena.h"
 #include <iostream>
-#include <set>
 #include <string>
 #include <thread>
 #include <chrono>
+#include <cstdlib>
 #include <ctime>
 #include <fstream>
 #include <nlohmann/json.hpp>
 using json = nlohmann::json;
 Logger logger("logs/debug.log", LOG_DEBUG);
-void exportTelemetryToJson(const std::vector<EmailContent>& telemetryHistory) {
+// Optional per-campaign TX array revisions, e.g.
+// { "campaigns": [ { "imei": "300534065390120", "firstMomsn": 0, "lastMomsn": 88, "layout": "v4.1" } ] }
+std::vector<LayoutRange> loadLayoutSchedule(const std::string& path) {
+    std::vector<LayoutRange> schedule;
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        logger.log(LOG_INFO, "No frame layout schedule at " + path + ", using newest layout per frame size");
+        return schedule;
+    }
     try {
-        json telemetryArray = json::array();
-        for (const auto& telemetry : telemetryHistory) {
-            json entry = {
-                {"momsn", telemetry.momsn},
-                {"imei", telemetry.imei},
-                {"transmitTime", telemetry.transmitTime},
-                {"iridiumLatitude", telemetry.iridiumLatitude},
-                {"iridiumLongitude", telemetry.iridiumLongitude},
-                {"iridiumCep", telemetry.iridiumCep},
-                {"sessionStatus", telemetry.sessionStatus},
-                {"hexData", telemetry.hexData},
-                {"isValid", telemetry.isValid}
-            };
-
-            if (telemetry.payload.isValid) {
-                const auto& p = telemetry.payload;
-                entry["payload"] = {
-                    // Manufacturer header
-                    {"header", p.header},
-                    {"headerValid", p.headerValid},
-                    {"serialNumber", p.serialNumber},
-
-                    // Flight status
-                    {"flightStatus", {
-                        {"raw", p.flightStatus.raw},
-                        {"phase", p.flightStatus.getPhaseString()},
-                        {"btRxSuccess", p.flightStatus.btRxSuccess},
-                        {"btRxFailure", p.flightStatus.btRxFailure},
-                        {"balloonBurst", p.flightStatus.balloonBurst},
-                        {"descent", p.flightStatus.descent},
-                        {"ascent", p.flightStatus.ascent},
-                        {"landing", p.flightStatus.landing}
-                    }},
-
-                    // GNSS
-                    {"gnssValid", p.gnssValid},
-                    {"utcHours", p.utcHours},
-                    {"utcMinutes", p.utcMinutes},
-                    {"utcSeconds", p.utcSeconds},
-                    {"latitude", p.latitude},
-                    {"longitude", p.longitude},
-                    {"altitude", p.altitude},
-                    {"altitudeUnits", p.altitudeUnits},
-
-                    // AHT20
-                    {"aht20", {
-                        {"humidityRH", p.aht20.humidityRH},
-                        {"tempC", p.aht20.tempC},
-                        {"tempF", p.aht20.tempF},
-                        {"status", p.aht20.status},
-                        {"statusString", p.aht20.statusString()},
-                        {"isValid", p.aht20.isValid}
-                    }},
-
-                    // Radio
-                    {"radio", {
-                        {"stationIndex", p.radio.stationIndex},
-                        {"frequencyMHz", p.radio.frequencyMHz},
-                        {"signalStrength", p.radio.signalStrength},
-                        {"stereo", p.radio.stereo}
-                    }},
-
-                    // Analog sensors
-                    {"sensors", {
-                        {"masterBattery", {
-                            {"name", p.masterBattery.name},
-                            {"voltage", p.masterBattery.voltage},
-                            {"measurement", p.masterBattery.measurement},
-                            {"unit", p.masterBattery.unit},
-                            {"isValid", p.masterBattery.isValid}
-                        }},
-                        {"slaveBattery", {
-                            {"name", p.slaveBattery.name},
-                            {"voltage", p.slaveBattery.voltage},
-                            {"measurement", p.slaveBattery.measurement},
-                            {"unit", p.slaveBattery.unit},
-                            {"isValid", p.slaveBattery.isValid}
-                        }},
-                        {"internalTemp", {
-                            {"name", p.internalTemp.name},
-                            {"voltage", p.internalTemp.voltage},
-                            {"measurement", p.internalTemp.measurement},
-                            {"unit", p.internalTemp.unit},
-                            {"isValid", p.internalTemp.isValid}
-                        }},
-                        {"externalTemp", {
-                            {"name", p.externalTemp.name},
-                            {"voltage", p.externalTemp.voltage},
-                            {"measurement", p.externalTemp.measurement},
-                            {"unit", p.externalTemp.unit},
-                            {"isValid", p.externalTemp.isValid}
-                        }}
-                    }},
-
-                    // Modem
-                    {"modem", {
-                        {"currentCode", p.modem.currentCode},
-                        {"currentDesc", p.modem.currentDesc},
-                        {"previousCode", p.modem.previousCode},
-                        {"previousDesc", p.modem.previousDesc},
-                        {"txSuccessCount", p.modem.txSuccessCount}
-                    }},
-
-                    {"recordSequence", p.recordSequence}
-                };
+        json j;
+        file >> j;
+        for (const auto& c : j.value("campaigns", json::array())) {
+            LayoutRange r;
+            r.imei = c.value("imei", "");
+            r.firstMomsn = c.value("firstMomsn", 0);
+            r.lastMomsn = c.value("lastMomsn", 0);
+            std::string name = c.value("layout", "");
+            if (!FrameRegistry::parseVersion(name, r.version)) {
+                logger.log(LOG_WARNING, "Unknown frame layout '" + name + "' in " + path);
+                continue;
             }
-            telemetryArray.push_back(entry);
+            schedule.push_back(r);
         }
+        logger.log(LOG_INFO, "Loaded " + std::to_string(schedule.size()) + " frame layout range(s)");
+    } catch (const json::exception& e) {
+        logger.log(LOG_ERROR, "Failed to parse frame layout schedule: " + std::string(e.what()));
+    }
+    return schedule;
+}
 
-        json output = {
-            {"lastUpdated", std::time(nullptr)},
-            {"totalRecords", telemetryHistory.size()},
-            {"telemetry", telemetryArray}
-        };
+// Environment overrides for the Google endpoints (local HTTPS stand-in)
+std::string envOr(const char* name, const std::string& fallback) {
+    const char* value = std::getenv(name);
+    return (value && *value) ? value : fallback;
+}
 
-        std::ofstream file("dashboard/data/telemetry.json");
-        if (file.is_open()) {
-            file << output.dump(2);
-            file.close();
-            logger.log(LOG_INFO, "Exported " + std::to_string(telemetryHistory.size()) + " records to JSON");
-        } else {
-            logger.log(LOG_ERROR, "Failed to open telemetry.json for writing");
-        }
-    } catch (const std::exception& e) {
-        logger.log(LOG_ERROR, "Error exporting to JSON: " + std::string(e.what()));
+// Gmail Pub/Sub push: {"message": {"data": "<base64 {emailAddress, historyId}>", ...}, "subscription": ...}
+// The payload only says the mailbox changed; the fetch itself goes through GmailClient as usual.
+HttpReply handleGmailPush(const HttpRequest& req, IngestEvents& events) {
+    HttpReply reply;
+    if (!PUSH_TOKEN.empty() && req.queryParam("token") != PUSH_TOKEN) {
+        logger.log(LOG_WARNING, "Rejected push notification with a bad token");
+        reply.status = 403;
+        return reply;
+    }
+    json body = json::parse(req.body, nullptr, false);
+    if (body.is_discarded() || !body.contains("message") || !body["message"].is_object()) {
+        logger.log(LOG_WARNING, "Rejected malformed push notification");
+        reply.status = 400;
+        reply.body = "expected a Pub/Sub push message\n";
+        return reply;
     }
+    logger.log(LOG_INFO, "Push notification received (message " +
+        body["message"].value("messageId", std::string("?")) + "), fetching now");
+    events.notifyMailbox();
+    reply.status = 204;
+    return reply;
+}
+
+// RockBLOCK HTTP POST delivery: the frame arrives as form fields, so it is
+// decoded here and queued for main() without going through Gmail. RockBLOCK
+// retries until it gets a 200 and never again after one, so a usable frame
+// is appended to the archive before the reply; if that fails the reply is
+// 503 and RockBLOCK delivers it again later. Only frames we cannot use are
+// refused outright. A retried frame may be archived twice; replay skips
+// the copy.
+HttpReply handleRockBlockPost(const HttpRequest& req, Decoder& decoder, TelemetryArchive& archive,
+                              IngestEvents& events) {
+    HttpReply reply;
+    if (!PUSH_TOKEN.empty() && req.queryParam("token") != PUSH_TOKEN) {
+        logger.log(LOG_WARNING, "Rejected RockBLOCK POST with a bad token");
+        reply.status = 403;
+        return reply;
+    }
+    EmailContent telemetry = decoder.parseRockBlockForm(req.body);
+    if (!telemetry.isValid) {
+        reply.status = 400;
+        reply.body = "expected imei and data form fields\n";
+        return reply;
+    }
+    if (telemetry.payload.isValid && archive.isOpen() && !archive.append(telemetry)) {
+        reply.status = 503;
+        reply.body = "could not store the frame, retry later\n";
+        return reply;
+    }
+    events.pushFrame(std::move(telemetry));
+    reply.body = "OK\n";
+    return reply;
 }
 
 int main() {
-    std::shared_ptr auth = std::make_shared<GmailAuth>(PATH_TO_SECRET, PATH_TO_TOKEN);
+    // ASCEND_INSECURE_TLS=1 skips certificate checks for a self-signed local stand-in
+    auto session = std::make_shared<HttpSession>(envOr("ASCEND_INSECURE_TLS", "") != "1");
+    std::shared_ptr auth = std::make_shared<GmailAuth>(PATH_TO_SECRET, PATH_TO_TOKEN, session,
+        envOr("ASCEND_OAUTH_TOKEN_URL", OAUTH_TOKEN_URL));
     if (!auth->authenticate()) {
         logger.log(LOG_ERROR, "Authentication failed!");
         return 1;
     }
 
-    GmailClient client(auth);
+    GmailClient client(auth, session, envOr("ASCEND_GMAIL_API_URL", GMAIL_API_BASE_URL));
+    client.setMaxConcurrentFetches(MAX_CONCURRENT_FETCHES);
+    client.setBatch(envOr("ASCEND_GMAIL_BATCH_URL", GMAIL_BATCH_URL), GMAIL_BATCH_SIZE);
+    if (!PATH_TO_HISTORY_CHECKPOINT.empty()) client.enableHistorySync(PATH_TO_HISTORY_CHECKPOINT);
     Decoder decoder;
-    std::set<std::string> processedIds;
-    std::vector<EmailContent> telemetryHistory;
+    decoder.setLayoutSchedule(loadLayoutSchedule(PATH_TO_FRAME_LAYOUTS));
+    TelemetryStore telemetryHistory;
+    TelemetryExporter exporter("dashboard/data");
+    TelemetryArchive archive(PATH_TO_TELEMETRY_ARCHIVE);
+    if (archive.open()) {
+        archive.replay(decoder, telemetryHistory);
+    } else {
+        logger.log(LOG_WARNING, "Telemetry archive unavailable, history will not survive a restart");
+    }
     time_t lastCheckTime = time(nullptr);
 
+    IngestEvents events;
+    HttpServer server;
+    DashboardServer dashboard(server, "dashboard");
+    exporter.exportNew(telemetryHistory);
+    dashboard.publish(telemetryHistory);
+    if (HTTP_PORT > 0) {
+        server.route("POST", "/gmail/push", [&events](const HttpRequest& req) { return handleGmailPush(req, events); });
+        server.route("POST", "/rockblock", [&decoder, &archive, &events](const HttpRequest& req) {
+            return handleRockBlockPost(req, decoder, archive, events);
+        });
+        if (!server.start(HTTP_BIND_ADDRESS, static_cast<uint16_t>(HTTP_PORT))) {
+            logger.log(LOG_WARNING, "Push listener unavailable, falling back to polling only");
+        }
+    }
+
+    logger.log(LOG_INFO, "Telemetry store: ~" + std::to_string(telemetryHistory.bytesPerRecord()) + " bytes/record");
     logger.log(LOG_INFO, "Monitoring started, polling every " +
         std::to_string(POLL_INTERVAL_MINUTES) + " minutes...");
 
+    // Same checks for frames from Gmail and from RockBLOCK POSTs; the POST
+    // handler has already archived its frames
+    auto ingest = [&](const EmailContent& telemetry, bool archived) {
+        // Overlapping searches (history fallback) or both delivery paths can return a frame twice
+        if (telemetry.isValid && telemetryHistory.contains(telemetry.imei, telemetry.momsn)) {
+            logger.log(LOG_DEBUG, "MOMSN " + std::to_string(telemetry.momsn) + " already stored, skipping");
+            return;
+        }
+        if (telemetry.isValid && telemetry.payload.isValid) {
+            telemetryHistory.append(telemetry);
+            if (!archived) archive.append(telemetry);
+            dashboard.publish(telemetryHistory);  // live to /stream clients right away
+            logger.log(LOG_INFO, "\n" + telemetry.toString() + "\n");
+        } else {
+            logger.log(LOG_WARNING, "Failed to parse valid telemetry from message");
+        }
+    };
+
+    ScratchArena& scratch = ScratchArena::forThread();
+    IngestEvents::Wake wake;
+    wake.timedOut = true;  // poll Gmail once at startup
     while (true) {
         try {
-            std::vector<GmailMessage> message = client.getMessageAfter(lastCheckTime, MODEM_EMAIL);
-            logger.log(LOG_INFO, "Found " + std::to_string(message.size()) + " new message(s)");
+            for (const EmailContent& telemetry : wake.frames) {
+                logger.log(LOG_INFO, "Processing RockBLOCK POST, MOMSN " + std::to_string(telemetry.momsn));
+                ingest(telemetry, true);
+            }
 
-            bool newDataAdded = false;
-            for (size_t i = 0; i < message.size(); ++i) {
-                const GmailMessage msg = message[i];
-                logger.log(LOG_INFO, "Processing message from: " + msg.from);
+            if (wake.timedOut || wake.mailboxChanged) {
+                // Built in the scratch arena, which is reset below
+                std::vector<GmailMessage> message = client.getNewMessages(lastCheckTime, MODEM_EMAIL);
+                logger.log(LOG_INFO, "Found " + std::to_string(message.size()) + " new message(s)");
 
-                if (processedIds.count(msg.id) > 0) continue;
+                for (size_t i = 0; i < message.size(); ++i) {
+                    const GmailMessage& msg = message[i];
+                    ASCEND_LOG(LOG_INFO, "Processing message from: {}", msg.from);
 
-                EmailContent telemetry = decoder.parseEmail(msg.bodyText);
-                if (telemetry.isValid && telemetry.payload.isValid) {
-                    telemetryHistory.push_back(telemetry);
-                    newDataAdded = true;
-                    logger.log(LOG_INFO, "\n" + telemetry.toString() + "\n");
-                } else {
-                    logger.log(LOG_WARNING, "Failed to parse valid telemetry from message");
-                    logger.log(LOG_INFO, "Body preview: " + msg.bodyText.substr(0, 200));
+                    EmailContent telemetry = decoder.parseEmail(msg.bodyText);
+                    ingest(telemetry, false);
+                    if (!telemetry.isValid || !telemetry.payload.isValid) {
+                        ASCEND_LOG(LOG_INFO, "Body preview: {}", std::string_view(msg.bodyText).substr(0, 200));
+                    }
                 }
-                processedIds.insert(msg.id);
+                lastCheckTime = time(nullptr);
             }
 
-            if (newDataAdded || telemetryHistory.size() > 0) {
-                exportTelemetryToJson(telemetryHistory);
-            }
-            lastCheckTime = time(nullptr);
+            exporter.exportNew(telemetryHistory);  // no-op when nothing new
         } catch (const std::exception& e) {
             logger.log(LOG_ERROR, "Error: " + std::string(e.what()));
         }
+        scratch.reset();  // this cycle's responses, parser state and messages
 
-        logger.log(LOG_INFO, "Waiting " + std::to_string(POLL_INTERVAL_MINUTES) + " minutes...");
-        std::this_thread::sleep_for(std::chrono::minutes(POLL_INTERVAL_MINUTES));
+        logger.log(LOG_INFO, "Waiting up to " + std::to_string(POLL_INTERVAL_MINUTES) + " minutes for a push notification...");
+        wake = events.waitFor(std::chrono::minutes(POLL_INTERVAL_MINUTES));
+        if (wake.timedOut) logger.log(LOG_DEBUG, "No push notification, polling");
     }
     return 0;
 }
\ No newline at end of file
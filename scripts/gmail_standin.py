@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+"""Local HTTPS stand-in for the Google endpoints the daemon talks to.
+
+Serves just enough of Gmail and OAuth to run the ingest daemon without
+a Google account: the token refresh, users.getProfile, users.history.list
+(paged), messages.list (after: search), messages.get (format=full) and
+the multipart/mixed batch endpoint. The mailbox holds one RockBLOCK
+email per frame of the dashboard corpus (dashboard/data/telemetry.json).
+
+Run it (a self-signed certificate is made with openssl unless --cert and
+--key are given):
+
+    scripts/gmail_standin.py --port 8443
+
+and point the daemon at it from its working directory:
+
+    mkdir -p env logs dashboard/data
+    echo '{"installed":{"client_id":"id","client_secret":"secret"}}' > env/client_secret.json
+    echo '{"access_token":"t","refresh_token":"r","token_expiry":0}' > env/token_cache.json
+    echo '{"historyId":"1000"}' > env/history_checkpoint.json   # replay every message
+    ASCEND_INSECURE_TLS=1 \\
+    ASCEND_OAUTH_TOKEN_URL=https://127.0.0.1:8443/token \\
+    ASCEND_GMAIL_API_URL=https://127.0.0.1:8443/gmail/v1/users/me \\
+    ASCEND_GMAIL_BATCH_URL=https://127.0.0.1:8443/batch/gmail/v1 \\
+    ./ascend
+
+Message k of the corpus is added at historyId 1001 + k; the profile
+reports the last one, so a checkpoint of 1000 replays the whole corpus
+and anything below 1000 has "expired" (404, search fallback). Failure
+injection, for the retry and checkpoint paths:
+
+    --fail ID      messages.get for ID answers 500 (503 inside a batch)
+    --gone ID      messages.get for ID answers 404, as for a deleted message
+    --garbage ID   messages.get for ID answers 200 with a body that is not JSON
+
+IDs are "m<MOMSN>"; each option can be repeated.
+"""
+
+import argparse
+import base64
+import json
+import os
+import ssl
+import subprocess
+import sys
+import tempfile
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+FIRST_HISTORY_ID = 1000
+HISTORY_PAGE_SIZE = 2
+API_PREFIX = "/gmail/v1/users/me"
+BATCH_PATH = "/batch/gmail/v1"
+RESPONSE_BOUNDARY = "batch_standin_b7"
+
+ROCKBLOCK_BODY = (
+    "IMEI: {imei}\r\nMOMSN: {momsn}\r\nTransmit Time: {transmitTime}\r\n"
+    "Iridium Latitude: {iridiumLatitude}\r\nIridium Longitude: {iridiumLongitude}\r\n"
+    "Iridium CEP: {iridiumCep}\r\nIridium Session Status: {sessionStatus}\r\n"
+    "Data:\r\n{hexData}\r\n"
+)
+
+
+class Mailbox:
+    def __init__(self, corpus_path, fail, gone, garbage):
+        with open(corpus_path) as f:
+            frames = json.load(f)["telemetry"]
+        frames.sort(key=lambda t: t["momsn"])
+        self.messages = [self._message(t) for t in frames]
+        self.fail, self.gone, self.garbage = set(fail), set(gone), set(garbage)
+
+    @staticmethod
+    def _message(t):
+        sender = "%s@rockblock.rock7.com" % t["imei"]
+        body = ROCKBLOCK_BODY.format(**{"sessionStatus": 0, **t})
+        return {
+            "id": "m%d" % t["momsn"],
+            "threadId": "t%d" % t["momsn"],
+            "snippet": "IMEI: %s MOMSN: %d" % (t["imei"], t["momsn"]),
+            "payload": {
+                "mimeType": "text/plain",
+                "headers": [
+                    {"name": "From", "value": sender},
+                    {"name": "To", "value": "ground@example.com"},
+                    {"name": "Subject", "value": "Message %d from RockBLOCK %s" % (t["momsn"], t["imei"])},
+                ],
+                "body": {"data": base64.urlsafe_b64encode(body.encode()).decode().rstrip("=")},
+            },
+        }
+
+    def latest_history_id(self):
+        return FIRST_HISTORY_ID + len(self.messages)
+
+    def get(self, message_id):
+        """(status, body) for messages.get"""
+        if message_id in self.gone:
+            return 404, {"error": {"code": 404, "message": "Requested entity was not found."}}
+        if message_id in self.fail:
+            return 500, {"error": {"code": 500, "message": "Backend Error"}}
+        if message_id in self.garbage:
+            return 200, "<html>not a message</html>"
+        for m in self.messages:
+            if m["id"] == message_id:
+                return 200, m
+        return 404, {"error": {"code": 404, "message": "Requested entity was not found."}}
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    mailbox = None
+    verbose = False
+
+    def log_message(self, fmt, *args):
+        if self.verbose:
+            sys.stderr.write("%s\n" % (fmt % args))
+
+    def reply(self, status, body, content_type="application/json; charset=UTF-8"):
+        data = body if isinstance(body, bytes) else (body if isinstance(body, str) else json.dumps(body)).encode()
+        self.send_response(status)
+        self.send_header("Content-Type", content_type)
+        self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def do_GET(self):
+        url = urlparse(self.path)
+        query = {k: v[0] for k, v in parse_qs(url.query).items()}
+        if not url.path.startswith(API_PREFIX + "/"):
+            return self.reply(404, {"error": {"code": 404}})
+        status, body = self.api_get(url.path[len(API_PREFIX):], query)
+        self.reply(status, body)
+
+    def api_get(self, path, query):
+        box = self.mailbox
+        if path == "/profile":
+            return 200, {"emailAddress": "ground@example.com", "historyId": str(box.latest_history_id())}
+        if path == "/history":
+            start = int(query.get("startHistoryId", "0"))
+            if start < FIRST_HISTORY_ID:
+                return 404, {"error": {"code": 404, "message": "Requested entity was not found."}}
+            offset = int(query.get("pageToken", "0"))
+            added = [(FIRST_HISTORY_ID + 1 + k, m) for k, m in enumerate(box.messages)
+                     if FIRST_HISTORY_ID + 1 + k > start]
+            page = added[offset:offset + HISTORY_PAGE_SIZE]
+            body = {"historyId": str(box.latest_history_id())}
+            if page:
+                body["history"] = [{"id": str(h), "messagesAdded": [{"message": {"id": m["id"], "threadId": m["threadId"]}}]}
+                                   for h, m in page]
+            if offset + HISTORY_PAGE_SIZE < len(added):
+                body["nextPageToken"] = str(offset + HISTORY_PAGE_SIZE)
+            return 200, body
+        if path == "/messages":
+            # Newest first, like Gmail; the after:/from: query is not evaluated
+            refs = [{"id": m["id"], "threadId": m["threadId"]} for m in reversed(box.messages)]
+            return 200, {"messages": refs, "resultSizeEstimate": len(refs)}
+        if path.startswith("/messages/"):
+            return box.get(path[len("/messages/"):])
+        return 404, {"error": {"code": 404}}
+
+    def do_POST(self):
+        length = int(self.headers.get("Content-Length", "0"))
+        data = self.rfile.read(length).decode("utf-8", "replace")
+        path = urlparse(self.path).path
+        if path == "/token":
+            return self.reply(200, {"access_token": "standin-token", "expires_in": 3600, "token_type": "Bearer"})
+        if path == BATCH_PATH:
+            return self.batch(data)
+        self.reply(404, {"error": {"code": 404}})
+
+    def batch(self, data):
+        content_type = self.headers.get("Content-Type", "")
+        if "boundary=" not in content_type:
+            return self.reply(400, {"error": {"code": 400, "message": "missing boundary"}})
+        boundary = content_type.split("boundary=", 1)[1].split(";")[0].strip().strip('"')
+        parts = []
+        for part in data.split("--" + boundary)[1:]:
+            if part.startswith("--"):
+                break
+            content_id = ""
+            for line in part.splitlines():
+                if line.lower().startswith("content-id:"):
+                    content_id = line.split(":", 1)[1].strip().strip("<>")
+            request_line = next((l for l in part.splitlines() if l.startswith("GET ")), None)
+            if request_line is None:
+                continue
+            path = urlparse(request_line.split()[1])
+            parts.append((content_id, path.path))
+
+        # Answered in reverse order so clients must match on Content-ID
+        out = []
+        for content_id, path in reversed(parts):
+            status, body = self.api_get(path[len(API_PREFIX):], {}) if path.startswith(API_PREFIX) else (404, {})
+            if status == 500:
+                status = 503  # what Gmail returns for an over-busy batch item
+            text = body if isinstance(body, str) else json.dumps(body)
+            reason = {200: "OK", 404: "Not Found", 503: "Service Unavailable"}.get(status, "Error")
+            out.append("--%s\r\nContent-Type: application/http\r\nContent-ID: <response-%s>\r\n\r\n"
+                       "HTTP/1.1 %d %s\r\nContent-Type: application/json; charset=UTF-8\r\n\r\n%s\r\n"
+                       % (RESPONSE_BOUNDARY, content_id, status, reason, text))
+        out.append("--%s--\r\n" % RESPONSE_BOUNDARY)
+        self.reply(200, "".join(out), "multipart/mixed; boundary=%s" % RESPONSE_BOUNDARY)
+
+
+def self_signed_cert(directory):
+    cert, key = os.path.join(directory, "cert.pem"), os.path.join(directory, "key.pem")
+    subprocess.run(["openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes", "-days", "2",
+                    "-subj", "/CN=127.0.0.1", "-keyout", key, "-out", cert],
+                   check=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    return cert, key
+
+
+def main():
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--port", type=int, default=8443)
+    parser.add_argument("--corpus", default=os.path.join(root, "dashboard", "data", "telemetry.json"))
+    parser.add_argument("--cert")
+    parser.add_argument("--key")
+    parser.add_argument("--fail", action="append", default=[], metavar="ID")
+    parser.add_argument("--gone", action="append", default=[], metavar="ID")
+    parser.add_argument("--garbage", action="append", default=[], metavar="ID")
+    parser.add_argument("--verbose", action="store_true", help="log every request")
+    args = parser.parse_args()
+
+    Handler.mailbox = Mailbox(args.corpus, args.fail, args.gone, args.garbage)
+    Handler.verbose = args.verbose
+
+    with tempfile.TemporaryDirectory() as tmp:
+        cert, key = (args.cert, args.key) if args.cert and args.key else self_signed_cert(tmp)
+        context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        context.load_cert_chain(cert, key)
+        server = ThreadingHTTPServer(("127.0.0.1", args.port), Handler)
+        server.socket = context.wrap_socket(server.socket, server_side=True)
+        print("Gmail stand-in on https://127.0.0.1:%d (%d messages, historyId %d)"
+              % (args.port, len(Handler.mailbox.messages), Handler.mailbox.latest_history_id()), flush=True)
+        try:
+            server.serve_forever()
+        except KeyboardInterrupt:
+            pass
+
+
+if __name__ == "__main__":
+    main()
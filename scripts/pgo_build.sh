@@ -0,0 +1,25 @@
+#!/bin/bash
+# Profile-guided Release build of the daemon, trained on the benchmark
+# corpus (bench/, built from dashboard/data/telemetry.json).
+#
+#   scripts/pgo_build.sh [extra cmake args...]
+#
+#   1. instrumented build            (preset pgo-generate, build/pgo)
+#   2. run the benchmark suite       (writes .gcda profiles under build/pgo)
+#   3. rebuild with the profiles     (preset pgo-use, same directory)
+#
+# The optimized daemon is build/pgo/ascend. Needs Google Benchmark.
+# Run from the repository root.
+
+set -euo pipefail
+
+rm -rf build/pgo   # no stale profiles from an older tree
+
+cmake --preset pgo-generate "$@"
+cmake --build --preset pgo-generate
+cmake --build build/pgo --target pgo-train
+
+cmake --preset pgo-use "$@"
+cmake --build --preset pgo-use
+
+echo "PGO build done: build/pgo/ascend"
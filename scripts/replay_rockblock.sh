@@ -0,0 +1,53 @@
+#!/bin/bash
+# Replays stored frames against the RockBLOCK HTTP POST endpoint, the way
+# RockBLOCK delivers them (application/x-www-form-urlencoded).
+#
+#   scripts/replay_rockblock.sh [frames] [url] [delay_seconds]
+#
+#   frames  dashboard/data/telemetry.json ({"telemetry": [...]}) or a
+#           telemetry.ndjson export; default dashboard/data/telemetry.json
+#   url     default http://127.0.0.1:8080/rockblock (append ?token=... if PUSH_TOKEN is set)
+#   delay   pause between frames, default 0
+#
+# Needs curl and jq.
+
+set -euo pipefail
+
+FRAMES="${1:-dashboard/data/telemetry.json}"
+URL="${2:-http://127.0.0.1:8080/rockblock}"
+DELAY="${3:-0}"
+
+if [[ ! -f "$FRAMES" ]]; then
+    echo "No frames file at $FRAMES" >&2
+    exit 1
+fi
+
+if [[ "$FRAMES" == *.ndjson ]]; then
+    ROWS=$(jq -c '.' "$FRAMES")
+else
+    ROWS=$(jq -c '.telemetry[]' "$FRAMES")
+fi
+
+sent=0
+failed=0
+while IFS= read -r row; do
+    [[ -z "$row" ]] && continue
+    momsn=$(jq -r '.momsn' <<< "$row")
+    status=$(curl -s -o /dev/null -w '%{http_code}' -X POST "$URL" \
+        --data-urlencode "imei=$(jq -r '.imei' <<< "$row")" \
+        --data-urlencode "momsn=$momsn" \
+        --data-urlencode "transmit_time=$(jq -r '.transmitTime // ""' <<< "$row")" \
+        --data-urlencode "iridium_latitude=$(jq -r '.iridiumLatitude' <<< "$row")" \
+        --data-urlencode "iridium_longitude=$(jq -r '.iridiumLongitude' <<< "$row")" \
+        --data-urlencode "iridium_cep=$(jq -r '.iridiumCep' <<< "$row")" \
+        --data-urlencode "data=$(jq -r '.hexData' <<< "$row")") || status=000
+    if [[ "$status" == "200" ]]; then
+        sent=$((sent + 1))
+    else
+        failed=$((failed + 1))
+        echo "MOMSN $momsn: HTTP $status" >&2
+    fi
+    [[ "$DELAY" != "0" ]] && sleep "$DELAY"
+done <<< "$ROWS"
+
+echo "Replayed $sent frame(s) to $URL, $failed failed"
@@ -0,0 +1,268 @@
+#include "Base64.h"
+#include <algorithm>
+#include <array>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BASE64_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr uint8_t SEXTET_SPACE   = 0x40;
+constexpr uint8_t SEXTET_PAD     = 0x41;
+constexpr uint8_t SEXTET_INVALID = 0xFF;
+
+constexpr std::array<uint8_t, 256> makeSextetTable() {
+    std::array<uint8_t, 256> t{};
+    for (auto& v : t) v = SEXTET_INVALID;
+    for (int c = 'A'; c <= 'Z'; ++c) t[c] = static_cast<uint8_t>(c - 'A');
+    for (int c = 'a'; c <= 'z'; ++c) t[c] = static_cast<uint8_t>(c - 'a' + 26);
+    for (int c = '0'; c <= '9'; ++c) t[c] = static_cast<uint8_t>(c - '0' + 52);
+    t['-'] = t['+'] = 62;
+    t['_'] = t['/'] = 63;
+    t['='] = SEXTET_PAD;
+    t[' '] = t['\t'] = t['\r'] = t['\n'] = t['\v'] = t['\f'] = SEXTET_SPACE;
+    return t;
+}
+
+constexpr std::array<uint8_t, 256> SEXTET = makeSextetTable();
+
+#ifdef BASE64_X86
+
+// Block decoders in the style of Muła and Lemire's vectorized base64:
+// classify every char into its 6-bit value, then merge four sextets per
+// 32-bit lane into three bytes with two multiply-adds:
+//
+//   maddubs by 0x40,0x01   -> (a << 6 | b), (c << 6 | d)   per 16-bit lane
+//   madd    by 0x1000,0x01 -> a b c d as one 24-bit value  per 32-bit lane
+//
+// and a byte shuffle that drops the top byte and restores byte order.
+// Classification uses range compares rather than nibble lookup tables so
+// that both the URL-safe and the standard alphabet are accepted. A block
+// with any other char (whitespace, padding, junk) returns false and
+// writes nothing; the scalar path handles it.
+//
+// The stores are a full register wide (16 or 32 bytes for 12 or 24
+// decoded), but never past the end of the block just loaded, so decoding
+// over the input itself is safe.
+
+__attribute__((target("ssse3")))
+inline __m128i inRangeSsse3(__m128i c, char lo, char hi) {
+    // Signed compares: bytes >= 0x80 are negative and fall in no range
+    return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                         _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(hi + 1)), c));
+}
+
+__attribute__((target("ssse3")))
+bool decodeBlockSsse3(const char* src, uint8_t* dst) {
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i upper = inRangeSsse3(c, 'A', 'Z');
+    const __m128i lower = inRangeSsse3(c, 'a', 'z');
+    const __m128i digit = inRangeSsse3(c, '0', '9');
+    const __m128i s62 = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('-')), _mm_cmpeq_epi8(c, _mm_set1_epi8('+')));
+    const __m128i s63 = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('_')), _mm_cmpeq_epi8(c, _mm_set1_epi8('/')));
+    const __m128i symbol = _mm_or_si128(s62, s63);
+    const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, symbol));
+    if (_mm_movemask_epi8(valid) != 0xFFFF) return false;
+
+    const __m128i offset = _mm_or_si128(_mm_or_si128(
+        _mm_and_si128(upper, _mm_set1_epi8(static_cast<char>(-'A'))),
+        _mm_and_si128(lower, _mm_set1_epi8(static_cast<char>(26 - 'a')))),
+        _mm_and_si128(digit, _mm_set1_epi8(static_cast<char>(52 - '0'))));
+    const __m128i sextets = _mm_or_si128(
+        _mm_andnot_si128(symbol, _mm_add_epi8(c, offset)),
+        _mm_or_si128(_mm_and_si128(s62, _mm_set1_epi8(62)), _mm_and_si128(s63, _mm_set1_epi8(63))));
+
+    const __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+    const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    const __m128i bytes = _mm_shuffle_epi8(quads, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), bytes);
+    return true;
+}
+
+__attribute__((target("avx2")))
+inline __m256i inRangeAvx2(__m256i c, char lo, char hi) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), c));
+}
+
+// Same scheme, 32 chars -> 24 bytes. The shuffle works per 128-bit lane,
+// so the two 12-byte halves are joined with a 32-bit permute.
+__attribute__((target("avx2")))
+bool decodeBlockAvx2(const char* src, uint8_t* dst) {
+    const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    const __m256i upper = inRangeAvx2(c, 'A', 'Z');
+    const __m256i lower = inRangeAvx2(c, 'a', 'z');
+    const __m256i digit = inRangeAvx2(c, '0', '9');
+    const __m256i s62 = _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('-')),
+                                        _mm256_cmpeq_epi8(c, _mm256_set1_epi8('+')));
+    const __m256i s63 = _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('_')),
+                                        _mm256_cmpeq_epi8(c, _mm256_set1_epi8('/')));
+    const __m256i symbol = _mm256_or_si256(s62, s63);
+    const __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, symbol));
+    if (_mm256_movemask_epi8(valid) != -1) return false;
+
+    const __m256i offset = _mm256_or_si256(_mm256_or_si256(
+        _mm256_and_si256(upper, _mm256_set1_epi8(static_cast<char>(-'A'))),
+        _mm256_and_si256(lower, _mm256_set1_epi8(static_cast<char>(26 - 'a')))),
+        _mm256_and_si256(digit, _mm256_set1_epi8(static_cast<char>(52 - '0'))));
+    const __m256i sextets = _mm256_or_si256(
+        _mm256_andnot_si256(symbol, _mm256_add_epi8(c, offset)),
+        _mm256_or_si256(_mm256_and_si256(s62, _mm256_set1_epi8(62)), _mm256_and_si256(s63, _mm256_set1_epi8(63))));
+
+    const __m256i pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+    const __m256i quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    const __m256i bytes = _mm256_shuffle_epi8(quads, _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    const __m256i packed = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), packed);
+    return true;
+}
+
+bool cpuHasSsse3() {
+    static const bool has = __builtin_cpu_supports("ssse3");
+    return has;
+}
+
+bool cpuHasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+
+#endif
+
+} // namespace
+
+namespace Base64 {
+
+Simd bestSimd() {
+#ifdef BASE64_X86
+    if (cpuHasAvx2()) return Simd::Avx2;
+    if (cpuHasSsse3()) return Simd::Ssse3;
+#endif
+    return Simd::None;
+}
+
+Result decode(std::string_view in, std::span<uint8_t> out) {
+    return decode(in, out, bestSimd());
+}
+
+Result decode(std::string_view in, std::span<uint8_t> out, Simd simd) {
+    Result r;
+    const char* src = in.data();
+    const size_t n = in.size();
+    uint8_t* dst = out.data();
+    const size_t cap = out.size();
+    size_t i = 0;
+    size_t o = 0;
+    uint32_t acc = 0;    // sextets of a quad split by whitespace
+    int pending = 0;
+    size_t lastPos = 0;  // offset of the last sextet read
+
+#ifdef BASE64_X86
+    simd = std::min(simd, bestSimd());
+    const bool avx2 = simd >= Simd::Avx2;
+    const bool ssse3 = simd >= Simd::Ssse3;
+#else
+    (void)simd;
+#endif
+
+    while (i < n) {
+        if (pending == 0) {
+#ifdef BASE64_X86
+            if (avx2 && n - i >= 32 && cap - o >= 32 && decodeBlockAvx2(src + i, dst + o)) {
+                i += 32;
+                o += 24;
+                continue;
+            }
+            if (ssse3 && n - i >= 16 && cap - o >= 16 && decodeBlockSsse3(src + i, dst + o)) {
+                i += 16;
+                o += 12;
+                continue;
+            }
+#endif
+            // Scalar: a whole quad at once when all four chars are sextets
+            if (n - i >= 4) {
+                const uint8_t a = SEXTET[static_cast<uint8_t>(src[i])];
+                const uint8_t b = SEXTET[static_cast<uint8_t>(src[i + 1])];
+                const uint8_t c = SEXTET[static_cast<uint8_t>(src[i + 2])];
+                const uint8_t d = SEXTET[static_cast<uint8_t>(src[i + 3])];
+                if ((a | b | c | d) < 64) {
+                    if (cap - o < 3) {
+                        r.status = Status::Overflow;
+                        r.errorPos = i;
+                        break;
+                    }
+                    const uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+                    dst[o]     = static_cast<uint8_t>(v >> 16);
+                    dst[o + 1] = static_cast<uint8_t>(v >> 8);
+                    dst[o + 2] = static_cast<uint8_t>(v);
+                    i += 4;
+                    o += 3;
+                    continue;
+                }
+            }
+        }
+
+        // One char at a time around whitespace, padding and errors
+        const uint8_t v = SEXTET[static_cast<uint8_t>(src[i])];
+        if (v == SEXTET_SPACE) { ++i; continue; }
+        if (v == SEXTET_PAD) break;
+        if (v == SEXTET_INVALID) {
+            r.status = Status::InvalidChar;
+            r.errorPos = i;
+            break;
+        }
+        acc = (acc << 6) | v;
+        lastPos = i++;
+        if (++pending == 4) {
+            if (cap - o < 3) {
+                r.status = Status::Overflow;
+                r.errorPos = lastPos - 3;
+                break;
+            }
+            dst[o]     = static_cast<uint8_t>(acc >> 16);
+            dst[o + 1] = static_cast<uint8_t>(acc >> 8);
+            dst[o + 2] = static_cast<uint8_t>(acc);
+            o += 3;
+            acc = 0;
+            pending = 0;
+        }
+    }
+
+    // Unpadded tail, or the start of the quad an invalid char cut short:
+    // 2 chars -> 1 byte, 3 chars -> 2 bytes
+    if (pending == 1 && r.ok()) {
+        r.status = Status::BadLength;
+        r.errorPos = lastPos;
+    } else if (pending > 1 && r.status != Status::Overflow) {
+        if (cap - o < static_cast<size_t>(pending - 1)) {
+            if (r.ok()) {
+                r.status = Status::Overflow;
+                r.errorPos = lastPos;
+            }
+        } else if (pending == 2) {
+            dst[o++] = static_cast<uint8_t>(acc >> 4);
+        } else {
+            dst[o++] = static_cast<uint8_t>(acc >> 10);
+            dst[o++] = static_cast<uint8_t>(acc >> 2);
+        }
+    }
+
+    r.bytesWritten = o;
+    return r;
+}
+
+const char* statusString(Status status) {
+    switch (status) {
+        case Status::Ok:          return "OK";
+        case Status::InvalidChar: return "invalid character";
+        case Status::BadLength:   return "dangling final character";
+        case Status::Overflow:    return "more data than buffer";
+        default:                  return "unknown";
+    }
+}
+
+}
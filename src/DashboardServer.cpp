@@ -0,0 +1,196 @@
+#include "DashboardServer.h"
+#include "TelemetryExporter.h"
+#include "logger.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+extern Logger logger;
+
+namespace {
+
+// Changes on every start so a restarted daemon never matches an old ETag
+const std::string BOOT_ID = std::to_string(time(nullptr));
+
+// Comment line sent on idle streams so dead clients are noticed and proxies keep the connection
+constexpr std::chrono::seconds STREAM_KEEPALIVE{15};
+constexpr std::chrono::seconds STREAM_POLL{1};   // how often an idle stream checks for shutdown
+
+struct MimeType {
+    const char* extension;
+    const char* type;
+};
+
+constexpr MimeType MIME_TYPES[] = {
+    { ".html",   "text/html; charset=utf-8" },
+    { ".js",     "text/javascript; charset=utf-8" },
+    { ".css",    "text/css; charset=utf-8" },
+    { ".json",   "application/json" },
+    { ".ndjson", "application/x-ndjson" },
+    { ".png",    "image/png" },
+    { ".svg",    "image/svg+xml" },
+    { ".ico",    "image/x-icon" },
+};
+
+const char* mimeTypeFor(const std::string& path) {
+    for (const auto& m : MIME_TYPES) {
+        const std::string ext = m.extension;
+        if (path.size() >= ext.size() && path.compare(path.size() - ext.size(), ext.size(), ext) == 0) {
+            return m.type;
+        }
+    }
+    return "application/octet-stream";
+}
+
+uint64_t sinceParam(const HttpRequest& req) {
+    return std::strtoull(req.queryParam("since").c_str(), nullptr, 10);
+}
+
+// 304 when the client already has this state, otherwise fills in the
+// headers for a 200 and returns false
+bool notModified(const HttpRequest& req, const std::string& etag, HttpReply& reply) {
+    reply.headers.emplace_back("ETag", etag);
+    reply.headers.emplace_back("Cache-Control", "no-cache");
+    if (req.header("if-none-match") == etag) {
+        reply.status = 304;
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+DashboardServer::DashboardServer(HttpServer& server, std::string staticDir)
+    : staticDir_(std::move(staticDir)) {
+    server.route("GET", "/telemetry", [this](const HttpRequest& req) { return telemetry(req); });
+    server.route("GET", "/logs", [this](const HttpRequest& req) { return logs(req); });
+    server.routeStream("/stream", [this](const HttpRequest& req, HttpStream& out) { stream(req, out); });
+    server.setFallback([this](const HttpRequest& req) { return staticFile(req); });
+}
+
+void DashboardServer::publish(const TelemetryStore& store) {
+    // rows_ only grows here, on the main thread, so it can be sized without the lock
+    const size_t have = rows_.size();
+    if (store.size() <= have) return;
+
+    std::vector<std::string> added;
+    added.reserve(store.size() - have);
+    for (size_t i = have; i < store.size(); ++i) {
+        added.push_back(TelemetryExporter::rowToJson(store, i).dump(-1, ' ', true));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& row : added) rows_.push_back(std::move(row));
+    lastUpdated_ = time(nullptr);
+    published_.notify_all();
+}
+
+HttpReply DashboardServer::telemetry(const HttpRequest& req) const {
+    HttpReply reply;
+    uint64_t since = sinceParam(req);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t total = rows_.size();
+    if (notModified(req, "\"" + BOOT_ID + "-t" + std::to_string(total) + "\"", reply)) return reply;
+
+    // A client that holds more rows than exist is talking to a restarted daemon
+    const bool reset = since > total;
+    if (reset) since = 0;
+
+    std::string body = "{\"lastUpdated\":" + std::to_string(lastUpdated_) +
+        ",\"totalRecords\":" + std::to_string(total) +
+        ",\"next\":" + std::to_string(total) +
+        ",\"reset\":" + (reset ? "true" : "false") + ",\"records\":[";
+    for (size_t i = since; i < total; ++i) {
+        if (i > since) body += ',';
+        body += rows_[i];
+    }
+    body += "]}";
+
+    reply.contentType = "application/json";
+    reply.body = std::move(body);
+    return reply;
+}
+
+HttpReply DashboardServer::logs(const HttpRequest& req) const {
+    HttpReply reply;
+    const uint64_t latest = logger.latestSeq();
+    if (notModified(req, "\"" + BOOT_ID + "-l" + std::to_string(latest) + "\"", reply)) return reply;
+
+    reply.contentType = "application/json";
+    reply.body = Logger::logsToJson(logger.logsSince(sinceParam(req)), latest);
+    return reply;
+}
+
+void DashboardServer::stream(const HttpRequest& req, HttpStream& out) const {
+    std::string_view lastEventId = req.header("last-event-id");
+    size_t cursor = lastEventId.empty() ? sinceParam(req)
+                                        : std::strtoull(std::string(lastEventId).c_str(), nullptr, 10);
+
+    std::string batch = "retry: 3000\n\n";
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cursor > rows_.size()) {   // client is ahead of a restarted daemon
+            batch += "event: reset\ndata: {}\n\n";
+            cursor = 0;
+        }
+    }
+    logger.log(LOG_INFO, "Dashboard stream opened at record " + std::to_string(cursor));
+
+    auto lastSend = std::chrono::steady_clock::now();
+    while (out.active()) {
+        if (!batch.empty()) {
+            if (!out.send(batch)) break;
+            batch.clear();
+            lastSend = std::chrono::steady_clock::now();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        published_.wait_for(lock, STREAM_POLL, [&] { return rows_.size() > cursor; });
+        for (; cursor < rows_.size(); ++cursor) {
+            batch += "event: telemetry\nid: " + std::to_string(cursor + 1) + "\ndata: " + rows_[cursor] + "\n\n";
+        }
+        lock.unlock();
+
+        if (batch.empty() && std::chrono::steady_clock::now() - lastSend >= STREAM_KEEPALIVE) {
+            batch = ": keepalive\n\n";
+        }
+    }
+    logger.log(LOG_INFO, "Dashboard stream closed");
+}
+
+HttpReply DashboardServer::staticFile(const HttpRequest& req) const {
+    HttpReply reply;
+    if (req.method != "GET" && req.method != "HEAD") {
+        reply.status = 405;
+        return reply;
+    }
+    std::string path = req.path == "/" ? "/index.html" : HttpServer::urlDecode(req.path);
+    if (path.empty() || path[0] != '/' || path.find("..") != std::string::npos) {
+        reply.status = 404;
+        return reply;
+    }
+    const std::string file = staticDir_ + path;
+
+    struct stat st{};
+    if (::stat(file.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        reply.status = 404;
+        reply.body = "not found\n";
+        return reply;
+    }
+    const std::string etag = "\"" + std::to_string(st.st_size) + "-" + std::to_string(st.st_mtime) + "\"";
+    if (notModified(req, etag, reply)) return reply;
+
+    std::ifstream in(file, std::ios::binary);
+    if (!in.is_open()) {
+        reply.status = 404;
+        return reply;
+    }
+    std::ostringstream content;
+    content << in.rdbuf();
+    reply.contentType = mimeTypeFor(file);
+    reply.body = content.str();
+    return reply;
+}
@@ -1,331 +1,440 @@
 #include "Decoder.h"
+#include "FrameRegistry.h"
+#include "HexCodec.h"
 #include "logger.h"
-#include <regex>
 #include <sstream>
+#include <string_view>
+#include <charconv>
+#include <stdexcept>
 #include <iomanip>
 #include <cstring>
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <chrono>
+#include <thread>
 
 extern Logger logger;
 
 // ============================================================
-//   EMAIL PARSING (unchanged — same Rockblock email format)
+//   EMAIL PARSING (same Rockblock email format, single-pass scan)
 // ============================================================
 
-EmailContent Decoder::parseEmail(const std::string& bodyText) {
-    EmailContent telemetry;
-    try {
-        telemetry.imei = extractField(bodyText, "IMEI");
+namespace {
+
+// The RockBLOCK "Key: value" lines we care about. Anything else in the
+// body (forwarding headers, signatures, ...) is skipped by the scanner.
+enum class EmailField : uint8_t {
+    Imei, Momsn, TransmitTime, IridiumLatitude, IridiumLongitude,
+    IridiumCep, SessionStatus, Data, Count
+};
+
+struct EmailFieldKey {
+    std::string_view name;
+    EmailField field;
+};
+
+constexpr EmailFieldKey EMAIL_FIELD_KEYS[] = {
+    { "IMEI",                   EmailField::Imei },
+    { "MOMSN",                  EmailField::Momsn },
+    { "Transmit Time",          EmailField::TransmitTime },
+    { "Iridium Latitude",       EmailField::IridiumLatitude },
+    { "Iridium Longitude",      EmailField::IridiumLongitude },
+    { "Iridium CEP",            EmailField::IridiumCep },
+    { "Iridium Session Status", EmailField::SessionStatus },
+    { "Data",                   EmailField::Data },
+};
+
+constexpr size_t EMAIL_FIELD_COUNT = static_cast<size_t>(EmailField::Count);
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
 
-        std::string momsnStr = extractField(bodyText, "MOMSN");
-        if (!momsnStr.empty()) telemetry.momsn = std::stoi(momsnStr);
+std::string_view trimBlank(std::string_view v) {
+    while (!v.empty() && isBlank(v.front())) v.remove_prefix(1);
+    while (!v.empty() && isBlank(v.back()))  v.remove_suffix(1);
+    return v;
+}
 
-        telemetry.transmitTime = extractField(bodyText, "Transmit Time");
+// Values are trimmed of whitespace and of the " UTC" suffix that RockBLOCK
+// appends to Transmit Time.
+std::string_view trimValue(std::string_view v) {
+    v = trimBlank(v);
+    if (v.size() >= 3 && v.substr(v.size() - 3) == "UTC") {
+        v = trimBlank(v.substr(0, v.size() - 3));
+    }
+    return v;
+}
 
-        std::string latStr = extractField(bodyText, "Iridium Latitude");
-        if (!latStr.empty()) telemetry.iridiumLatitude = std::stod(latStr);
+// Forwarded mail may quote the original body ("> IMEI: ..."), so leading
+// quote markers are ignored when matching the key.
+bool matchEmailField(std::string_view key, EmailField& out) {
+    while (!key.empty() && (key.front() == '>' || isBlank(key.front()))) key.remove_prefix(1);
+    key = trimBlank(key);
+    for (const auto& k : EMAIL_FIELD_KEYS) {
+        if (key == k.name) {
+            out = k.field;
+            return true;
+        }
+    }
+    return false;
+}
 
-        std::string lonStr = extractField(bodyText, "Iridium Longitude");
-        if (!lonStr.empty()) telemetry.iridiumLongitude = std::stod(lonStr);
+template <typename T>
+T parseNumber(std::string_view value, std::string_view fieldName) {
+    T result{};
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (ec != std::errc() || ptr == value.data()) {
+        throw std::invalid_argument("malformed " + std::string(fieldName) + " '" + std::string(value) + "'");
+    }
+    return result;
+}
 
-        std::string cepStr = extractField(bodyText, "Iridium CEP");
-        if (!cepStr.empty()) telemetry.iridiumCep = std::stod(cepStr);
+// Copies the raw field values into telemetry; throws on malformed numbers
+void assignFields(EmailContent& telemetry, const std::string_view (&fields)[EMAIL_FIELD_COUNT]) {
+    auto field = [&](EmailField f) { return fields[static_cast<size_t>(f)]; };
+
+    telemetry.imei = field(EmailField::Imei);
+    telemetry.transmitTime = field(EmailField::TransmitTime);
+    telemetry.hexData = field(EmailField::Data);
+
+    if (!field(EmailField::Momsn).empty())
+        telemetry.momsn = parseNumber<int>(field(EmailField::Momsn), "MOMSN");
+    if (!field(EmailField::IridiumLatitude).empty())
+        telemetry.iridiumLatitude = parseNumber<double>(field(EmailField::IridiumLatitude), "Iridium Latitude");
+    if (!field(EmailField::IridiumLongitude).empty())
+        telemetry.iridiumLongitude = parseNumber<double>(field(EmailField::IridiumLongitude), "Iridium Longitude");
+    if (!field(EmailField::IridiumCep).empty())
+        telemetry.iridiumCep = parseNumber<double>(field(EmailField::IridiumCep), "Iridium CEP");
+    if (!field(EmailField::SessionStatus).empty())
+        telemetry.sessionStatus = parseNumber<int>(field(EmailField::SessionStatus), "Iridium Session Status");
+}
 
-        std::string statusStr = extractField(bodyText, "Iridium Session Status");
-        if (!statusStr.empty()) telemetry.sessionStatus = std::stoi(statusStr);
+// Form field names of the RockBLOCK HTTP POST delivery. The POST carries no
+// session status; device_type, serial and JWT fields are ignored.
+constexpr EmailFieldKey FORM_FIELD_KEYS[] = {
+    { "imei",              EmailField::Imei },
+    { "momsn",             EmailField::Momsn },
+    { "transmit_time",     EmailField::TransmitTime },
+    { "iridium_latitude",  EmailField::IridiumLatitude },
+    { "iridium_longitude", EmailField::IridiumLongitude },
+    { "iridium_cep",       EmailField::IridiumCep },
+    { "data",              EmailField::Data },
+};
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// application/x-www-form-urlencoded value: '+' is a space, %XX an escaped byte
+std::string formDecode(std::string_view v) {
+    std::string out;
+    out.reserve(v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        int hi, lo;
+        if (v[i] == '+') {
+            out += ' ';
+        } else if (v[i] == '%' && i + 2 < v.size() && (hi = hexDigit(v[i + 1])) >= 0 && (lo = hexDigit(v[i + 2])) >= 0) {
+            out += static_cast<char>(hi * 16 + lo);
+            i += 2;
+        } else {
+            out += v[i];
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+// Single pass over the body: every line is split at its first ':' and the key
+// is matched against EMAIL_FIELD_KEYS. The first occurrence of each field
+// wins. A key with nothing after the colon (RockBLOCK puts "Data:" on its own
+// line) takes the next non-blank line as its value.
+EmailContent Decoder::parseEmail(std::string_view bodyText) {
+    EmailContent telemetry;
+    try {
+        std::string_view fields[EMAIL_FIELD_COUNT];
+        bool seen[EMAIL_FIELD_COUNT] = {};
+        size_t remaining = EMAIL_FIELD_COUNT;
+        bool pending = false;
+        EmailField pendingField = EmailField::Count;
+
+        std::string_view text(bodyText);
+        size_t pos = 0;
+        while (pos < text.size() && (remaining > 0 || pending)) {
+            size_t eol = text.find('\n', pos);
+            if (eol == std::string_view::npos) eol = text.size();
+            std::string_view line = text.substr(pos, eol - pos);
+            pos = eol + 1;
+
+            if (pending) {
+                std::string_view value = trimValue(line);
+                if (value.empty()) continue;
+                fields[static_cast<size_t>(pendingField)] = value;
+                pending = false;
+                continue;
+            }
+
+            size_t colon = line.find(':');
+            if (colon == std::string_view::npos) continue;
+
+            EmailField field;
+            if (!matchEmailField(line.substr(0, colon), field)) continue;
+            size_t idx = static_cast<size_t>(field);
+            if (seen[idx]) continue;
+            seen[idx] = true;
+            --remaining;
+
+            std::string_view value = trimValue(line.substr(colon + 1));
+            if (value.empty()) {
+                pending = true;
+                pendingField = field;
+            } else {
+                fields[idx] = value;
+            }
+        }
 
-        telemetry.hexData = extractField(bodyText, "Data");
+        assignFields(telemetry, fields);
 
         if (!telemetry.hexData.empty()) {
-            telemetry.payload = decodeHexPayload(telemetry.hexData);
+            telemetry.payload = decodeHexPayload(telemetry.hexData, layoutFor(telemetry.imei, telemetry.momsn));
         }
 
         if (!telemetry.imei.empty() && !telemetry.hexData.empty()) {
             telemetry.isValid = true;
-            logger.log(LOG_INFO, "Parsed telemetry - MOMSN: " + std::to_string(telemetry.momsn));
+            ASCEND_LOG(LOG_INFO, "Parsed telemetry - MOMSN: {}", telemetry.momsn);
         } else {
-            logger.log(LOG_WARNING, "Parsed telemetry missing essential fields");
+            ASCEND_LOG(LOG_WARNING, "Parsed telemetry missing essential fields");
         }
     } catch (const std::exception& e) {
-        logger.log(LOG_ERROR, "Error parsing email: " + std::string(e.what()));
+        ASCEND_LOG(LOG_ERROR, "Error parsing email: {}", e.what());
         telemetry.isValid = false;
     }
     return telemetry;
 }
 
-std::string Decoder::extractField(const std::string& text, const std::string& fieldName) {
+// ============================================================
+//   ROCKBLOCK HTTP POST (form body, no email involved)
+// ============================================================
+
+// imei=300534065390120&momsn=81&transmit_time=25-04-12+18%3A02%3A11&iridium_latitude=33.694&...&data=5242...
+EmailContent Decoder::parseRockBlockForm(std::string_view formBody) {
+    EmailContent telemetry;
     try {
-        std::string pattern = fieldName + ":\\s*([^\\n\\r]+)";
-        std::regex fieldRegex(pattern);
-        std::smatch match;
-        if (std::regex_search(text, match, fieldRegex)) {
-            std::string value = match[1].str();
-            value.erase(0, value.find_first_not_of(" \t"));
-            value.erase(value.find_last_not_of(" \t\r\nUTC") + 1);
-            return value;
+        std::string values[EMAIL_FIELD_COUNT];
+        std::string_view fields[EMAIL_FIELD_COUNT];
+
+        while (!formBody.empty()) {
+            size_t amp = formBody.find('&');
+            std::string_view pair = formBody.substr(0, amp);
+            formBody.remove_prefix(amp == std::string_view::npos ? formBody.size() : amp + 1);
+
+            size_t eq = pair.find('=');
+            if (eq == std::string_view::npos) continue;
+            std::string_view key = pair.substr(0, eq);
+            for (const auto& k : FORM_FIELD_KEYS) {
+                if (key != k.name) continue;
+                size_t idx = static_cast<size_t>(k.field);
+                if (fields[idx].empty()) {
+                    values[idx] = formDecode(pair.substr(eq + 1));
+                    fields[idx] = trimBlank(values[idx]);
+                }
+                break;
+            }
+        }
+
+        assignFields(telemetry, fields);
+
+        if (!telemetry.hexData.empty()) {
+            telemetry.payload = decodeHexPayload(telemetry.hexData, layoutFor(telemetry.imei, telemetry.momsn));
+        }
+
+        if (!telemetry.imei.empty() && !telemetry.hexData.empty()) {
+            telemetry.isValid = true;
+            ASCEND_LOG(LOG_INFO, "Parsed RockBLOCK POST - MOMSN: {}", telemetry.momsn);
+        } else {
+            ASCEND_LOG(LOG_WARNING, "RockBLOCK POST missing imei or data");
         }
     } catch (const std::exception& e) {
-        logger.log(LOG_ERROR, "Error extracting field '" + fieldName + "': " + std::string(e.what()));
+        ASCEND_LOG(LOG_ERROR, "Error parsing RockBLOCK POST: {}", e.what());
+        telemetry.isValid = false;
     }
-    return "";
+    return telemetry;
 }
 
-std::vector<uint8_t> Decoder::hexStringToBytes(const std::string& hex) {
-    std::vector<uint8_t> bytes;
-    std::string cleanHex;
-    for (char c : hex) {
-        if (std::isxdigit(c)) cleanHex += c;
-    }
-    for (size_t i = 0; i + 1 < cleanHex.length(); i += 2) {
-        std::string byteString = cleanHex.substr(i, 2);
-        uint8_t byte = static_cast<uint8_t>(std::stoul(byteString, nullptr, 16));
-        bytes.push_back(byte);
+// ============================================================
+//   HEX PAYLOAD DECODE — frame layouts live in FrameRegistry
+// ============================================================
+
+namespace {
+
+// The offending value goes in every warning so junk frames can be told apart
+void logGnssFaults(const PayloadData& p) {
+    const uint16_t f = p.gnssFaults;
+    if (f & GnssFault::UTC_HOURS)      ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: UTC hours={} > 23", p.utcHours);
+    if (f & GnssFault::UTC_MINUTES)    ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: UTC minutes={} > 59", p.utcMinutes);
+    if (f & GnssFault::UTC_SECONDS)    ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: UTC seconds={} > 59", p.utcSeconds);
+    if (f & GnssFault::LAT_DEGREES)    ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: Lat degrees={} > 90", p.latitudeDMS.degrees);
+    if (f & GnssFault::LAT_MINUTES)    ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: Lat minutes={} > 59", p.latitudeDMS.minutes);
+    if (f & GnssFault::LAT_SECONDS)    ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: Lat seconds={} > 59", p.latitudeDMS.seconds);
+    if (f & GnssFault::LON_DEGREES)    ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: Lon degrees={} > 180", p.longitudeDMS.degrees);
+    if (f & GnssFault::LON_MINUTES)    ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: Lon minutes={} > 59", p.longitudeDMS.minutes);
+    if (f & GnssFault::LON_SECONDS)    ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: Lon seconds={} > 59", p.longitudeDMS.seconds);
+    if (f & GnssFault::LAT_HEMISPHERE)
+        ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: Lat hemisphere byte={} (expected 0 or 1)", p.latitudeDMS.hemisphereByte);
+    if (f & GnssFault::LON_HEMISPHERE)
+        ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: Lon hemisphere byte={} (expected 0 or 1)", p.longitudeDMS.hemisphereByte);
+    if (f & GnssFault::ALT_UNITS)
+        ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: Alt units byte={} (expected 0 or 1)", p.altitudeUnitsByte);
+    if (f & GnssFault::ALT_RANGE)      ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: Altitude={} out of range", p.altitude);
+    if (f & GnssFault::NO_LOCK)        ASCEND_LOG(LOG_WARNING, "  GNSS SANITY: All-zero GNSS — no satellite lock");
+}
+
+void logPayload(const PayloadData& payload) {
+    ASCEND_LOG(LOG_INFO, "  Layout: {}", FrameRegistry::versionName(payload.layout));
+    ASCEND_LOG(LOG_INFO, "  Header: {} {}", payload.headerText(),
+        payload.headerValid ? "Valid" : "Not Valid (expected 'RB')");
+    ASCEND_LOG(LOG_INFO, "  RockBLOCK Serial: {}", payload.serialNumber);
+
+    if (payload.layout == TxLayoutVersion::V4_1) {
+        ASCEND_LOG(LOG_INFO, "  Flight status: {} (raw=0x{:02X}) record#={}", payload.flightStatus.getPhaseString(),
+            payload.flightStatus.raw, payload.recordSequence);
+    } else {
+        ASCEND_LOG(LOG_INFO, "  Datalink: {} (raw=0x{:02X})", payload.btLinkGood ? "GOOD" : "BAD",
+            payload.datalinkByte);
     }
-    return bytes;
+
+    ASCEND_LOG(LOG_INFO, "  UTC: {}:{}:{}", payload.utcHours, payload.utcMinutes, payload.utcSeconds);
+    ASCEND_LOG(LOG_INFO, "  Lat: {}  Lon: {}", payload.latitude, payload.longitude);
+    ASCEND_LOG(LOG_INFO, "  Altitude: {} {}", payload.altitude, altitudeUnitName(payload.altitudeUnits));
+
+    logGnssFaults(payload);
+    ASCEND_LOG(LOG_INFO, "  GNSS Valid: {}", payload.gnssValid ? "YES" : "NO — junk data, will not plot");
+
+    ASCEND_LOG(LOG_INFO, "  AHT20: {}% RH, {} C ({} F) [{}]", payload.aht20.humidityRH,
+        payload.aht20.tempC, payload.aht20.tempF, payload.aht20.statusString());
+
+    ASCEND_LOG(LOG_INFO, "  Radio: {} MHz, signal={}/15 {} | sweep#={} peakSig={}", payload.radio.frequencyMHz,
+        payload.radio.signalStrength, payload.radio.stereo ? "STEREO" : "MONO",
+        payload.radio.sweepCount, payload.radio.peakSignal);
+
+    ASCEND_LOG(LOG_INFO, "  Master Batt: {} V", payload.masterBattery.measurement);
+    ASCEND_LOG(LOG_INFO, "  Slave Batt:  {} V", payload.slaveBattery.measurement);
+    ASCEND_LOG(LOG_INFO, "  Int Temp:    {} C", payload.internalTemp.measurement);
+    ASCEND_LOG(LOG_INFO, "  Ext Temp:    {} C", payload.externalTemp.measurement);
+
+    ASCEND_LOG(LOG_INFO, "  Modem: cur={} ({}), prev={} ({})", payload.modem.currentCode,
+        payload.modem.currentDesc(), payload.modem.previousCode, payload.modem.previousDesc());
 }
 
-// ============================================================
-//   HEX PAYLOAD DECODE — 50-byte frame (5 mfr + 45 TX v4.2)
-// ============================================================
+} // namespace
+
+PayloadData Decoder::decodeHexPayload(const std::string& hexString, TxLayoutVersion version) {
+    std::array<uint8_t, FrameRegistry::MAX_FRAME_SIZE> b;
+    HexCodec::Result hex = HexCodec::decode(hexString, b);
+    ASCEND_LOG(LOG_INFO, "Decoding hex payload: {}... ({} bytes)",
+        std::string_view(hexString).substr(0, 50), hex.bytesWritten);
+
+    if (hex.status == HexCodec::Status::Overflow) {
+        // Longer than any frame: decode the first MAX_FRAME_SIZE bytes as before
+        ASCEND_LOG(LOG_WARNING, "Payload longer than {} bytes, extra data ignored (from char {})",
+            FrameRegistry::MAX_FRAME_SIZE, hex.errorPos);
+    } else if (!hex.ok()) {
+        ASCEND_LOG(LOG_WARNING, "Malformed hex payload: {} at char {}",
+            HexCodec::statusString(hex.status), hex.errorPos);
+        return PayloadData{};
+    }
+    return decodeFrame(std::span<const uint8_t>(b.data(), hex.bytesWritten), version);
+}
 
-PayloadData Decoder::decodeHexPayload(const std::string& hexString) {
+PayloadData Decoder::decodeFrame(std::span<const uint8_t> frame, TxLayoutVersion version) {
     PayloadData payload;
     try {
-        std::vector<uint8_t> b = hexStringToBytes(hexString);
-        logger.log(LOG_INFO, "Decoding hex payload: " + hexString.substr(0, 50) +
-            "... (" + std::to_string(b.size()) + " bytes)");
-
-        if (static_cast<int>(b.size()) < PayloadIndex::EXPECTED_SIZE) {
-            logger.log(LOG_WARNING, "Payload too short: expected " +
-                std::to_string(PayloadIndex::EXPECTED_SIZE) + " bytes, got " +
-                std::to_string(b.size()));
+        const FrameRegistry::Entry* entry = FrameRegistry::find(version, frame.size());
+        if (!entry) {
+            const FrameRegistry::Entry* expected = (version == TxLayoutVersion::Auto)
+                ? FrameRegistry::forVersion(TxLayoutVersion::V4_2_4)
+                : FrameRegistry::forVersion(version);
+            ASCEND_LOG(LOG_WARNING, "Payload too short: expected {} bytes ({}), got {}",
+                expected ? expected->size : 0, FrameRegistry::versionName(version), frame.size());
             return payload;
         }
+        entry->project(frame.data(), payload);
+        logPayload(payload);
+    } catch (const std::exception& e) {
+        ASCEND_LOG(LOG_ERROR, "Error decoding hex payload: {}", e.what());
+        payload.isValid = false;
+    }
+    return payload;
+}
 
-        // ===== [0..1] MANUFACTURER HEADER =====
-        char h0 = static_cast<char>(b[PayloadIndex::HEADER_BYTE_0]);
-        char h1 = static_cast<char>(b[PayloadIndex::HEADER_BYTE_1]);
-        payload.header = std::string(1, h0) + std::string(1, h1);
-        payload.headerValid = (payload.header == "RB");
-        logger.log(LOG_INFO, "  Header: " + payload.header +
-            (payload.headerValid ? " Valid" : " Not Valid (expected 'RB')"));
-
-        // ===== [2..4] SERIAL NUMBER =====
-        payload.serialNumber = (b[PayloadIndex::SERIAL_BYTE_0] << 16) |
-                               (b[PayloadIndex::SERIAL_BYTE_1] << 8)  |
-                                b[PayloadIndex::SERIAL_BYTE_2];
-        logger.log(LOG_INFO, "  RockBLOCK Serial: " + std::to_string(payload.serialNumber));
-
-        // ===== [5] DATALINK BYTE =====
-        payload.datalinkByte = b[PayloadIndex::DATALINK_BYTE];
-        payload.btLinkGood   = (payload.datalinkByte == 0);
-        logger.log(LOG_INFO, "  Datalink: " + std::string(payload.btLinkGood ? "GOOD" : "BAD") +
-            " (raw=0x" +
-            ([](uint8_t v){ std::stringstream s; s << std::hex << std::uppercase
-            << std::setw(2) << std::setfill('0') << (int)v; return s.str(); })
-            (payload.datalinkByte) + ")");
-
-        // ===== [6..21] GNSS DATA FROM BT SLAVE =====
-        payload.utcHours   = b[PayloadIndex::UTC_HOURS];
-        payload.utcMinutes = b[PayloadIndex::UTC_MINUTES];
-        payload.utcSeconds = b[PayloadIndex::UTC_SECONDS];
-        logger.log(LOG_INFO, "  UTC: " + std::to_string(payload.utcHours) + ":" +
-            std::to_string(payload.utcMinutes) + ":" + std::to_string(payload.utcSeconds));
-
-        // Latitude DMS
-        payload.latitudeDMS.degrees   = b[PayloadIndex::LAT_DEGREES];
-        payload.latitudeDMS.minutes   = b[PayloadIndex::LAT_MINUTES];
-        payload.latitudeDMS.seconds   = b[PayloadIndex::LAT_SECONDS];
-        payload.latitudeDMS.hemisphere = (b[PayloadIndex::LAT_HEMISPHERE] == 0) ? 'N' : 'S';
-        payload.latitude = payload.latitudeDMS.degrees
-                         + (payload.latitudeDMS.minutes / 60.0)
-                         + (payload.latitudeDMS.seconds / 3600.0);
-        if (payload.latitudeDMS.hemisphere == 'S') payload.latitude = -payload.latitude;
-
-        // Longitude DMS
-        payload.longitudeDMS.degrees   = b[PayloadIndex::LON_DEGREES];
-        payload.longitudeDMS.minutes   = b[PayloadIndex::LON_MINUTES];
-        payload.longitudeDMS.seconds   = b[PayloadIndex::LON_SECONDS];
-        payload.longitudeDMS.hemisphere = (b[PayloadIndex::LON_HEMISPHERE] == 0) ? 'E' : 'W';
-        payload.longitude = payload.longitudeDMS.degrees
-                          + (payload.longitudeDMS.minutes / 60.0)
-                          + (payload.longitudeDMS.seconds / 3600.0);
-        if (payload.longitudeDMS.hemisphere == 'W') payload.longitude = -payload.longitude;
-
-        logger.log(LOG_INFO, "  Lat: " + std::to_string(payload.latitude) +
-            "  Lon: " + std::to_string(payload.longitude));
-
-        // Altitude (4 bytes big-endian)
-        payload.altitude = (static_cast<int32_t>(b[PayloadIndex::ALT_BYTE_0]) << 24) |
-                           (static_cast<int32_t>(b[PayloadIndex::ALT_BYTE_1]) << 16) |
-                           (static_cast<int32_t>(b[PayloadIndex::ALT_BYTE_2]) <<  8) |
-                            static_cast<int32_t>(b[PayloadIndex::ALT_BYTE_3]);
-        payload.altitudeUnits = (b[PayloadIndex::ALT_UNITS] == 0) ? "meters" : "feet";
-        logger.log(LOG_INFO, "  Altitude: " + std::to_string(payload.altitude) + " " + payload.altitudeUnits);
-
-        // ===== GNSS SANITY CHECKS =====
-        // The BT slave can send junk data. We still log everything
-        // but only set gnssValid=true if ALL checks pass.
-        {
-            bool sane = true;
-            // UTC range checks
-            if (payload.utcHours > 23) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: UTC hours=" + std::to_string(payload.utcHours) + " > 23");
-                sane = false;
-            }
-            if (payload.utcMinutes > 59) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: UTC minutes=" + std::to_string(payload.utcMinutes) + " > 59");
-                sane = false;
-            }
-            if (payload.utcSeconds > 59) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: UTC seconds=" + std::to_string(payload.utcSeconds) + " > 59");
-                sane = false;
-            }
-            // Latitude: degrees 0-90, minutes 0-59, seconds 0-59
-            if (payload.latitudeDMS.degrees > 90) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: Lat degrees=" + std::to_string(payload.latitudeDMS.degrees) + " > 90");
-                sane = false;
-            }
-            if (payload.latitudeDMS.minutes > 59) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: Lat minutes=" + std::to_string(payload.latitudeDMS.minutes) + " > 59");
-                sane = false;
-            }
-            if (payload.latitudeDMS.seconds > 59) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: Lat seconds=" + std::to_string(payload.latitudeDMS.seconds) + " > 59");
-                sane = false;
-            }
-            // Longitude: degrees 0-180, minutes 0-59, seconds 0-59
-            if (payload.longitudeDMS.degrees > 180) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: Lon degrees=" + std::to_string(payload.longitudeDMS.degrees) + " > 180");
-                sane = false;
-            }
-            if (payload.longitudeDMS.minutes > 59) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: Lon minutes=" + std::to_string(payload.longitudeDMS.minutes) + " > 59");
-                sane = false;
-            }
-            if (payload.longitudeDMS.seconds > 59) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: Lon seconds=" + std::to_string(payload.longitudeDMS.seconds) + " > 59");
-                sane = false;
-            }
-            // Hemisphere bytes must be 0 or 1
-            if (b[PayloadIndex::LAT_HEMISPHERE] > 1) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: Lat hemisphere byte=" + std::to_string(b[PayloadIndex::LAT_HEMISPHERE]) + " (expected 0 or 1)");
-                sane = false;
-            }
-            if (b[PayloadIndex::LON_HEMISPHERE] > 1) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: Lon hemisphere byte=" + std::to_string(b[PayloadIndex::LON_HEMISPHERE]) + " (expected 0 or 1)");
-                sane = false;
-            }
-            // Altitude units byte must be 0 or 1
-            if (b[PayloadIndex::ALT_UNITS] > 1) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: Alt units byte=" + std::to_string(b[PayloadIndex::ALT_UNITS]) + " (expected 0 or 1)");
-                sane = false;
-            }
-            // Altitude sanity: reject obviously absurd values (> 50,000 m or < -1000 m)
-            if (payload.altitude > 50000 || payload.altitude < -1000) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: Altitude=" + std::to_string(payload.altitude) + " out of range");
-                sane = false;
-            }
-            // All-zero GNSS block means no lock
-            if (payload.utcHours == 0 && payload.utcMinutes == 0 && payload.utcSeconds == 0 &&
-                payload.latitudeDMS.degrees == 0 && payload.latitudeDMS.minutes == 0 &&
-                payload.longitudeDMS.degrees == 0 && payload.longitudeDMS.minutes == 0) {
-                logger.log(LOG_WARNING, "  GNSS SANITY: All-zero GNSS — no satellite lock");
-                sane = false;
-            }
+size_t Decoder::decodeBatch(std::span<const FrameBytes> frames, std::span<PayloadData> out,
+                            TxLayoutVersion version, unsigned threads) {
+    if (out.size() < frames.size()) {
+        ASCEND_LOG(LOG_ERROR, "decodeBatch: output holds {} payloads, need {}", out.size(), frames.size());
+        return 0;
+    }
+    const FrameRegistry::Entry* entry = FrameRegistry::find(version, std::tuple_size_v<FrameBytes>);
+    if (!entry) {
+        ASCEND_LOG(LOG_ERROR, "decodeBatch: no {} decoder for {}-byte frames",
+            FrameRegistry::versionName(version), std::tuple_size_v<FrameBytes>);
+        return 0;
+    }
 
-            payload.gnssValid = sane;
-            logger.log(LOG_INFO, "  GNSS Valid: " + std::string(sane ? "YES" : "NO — junk data, will not plot"));
+    auto start = std::chrono::steady_clock::now();
+
+    // Small batches are not worth a thread start-up
+    constexpr size_t MIN_FRAMES_PER_THREAD = 1024;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t workers = std::min<size_t>(threads, (frames.size() + MIN_FRAMES_PER_THREAD - 1) / MIN_FRAMES_PER_THREAD);
+    workers = std::max<size_t>(workers, 1);
+
+    std::vector<size_t> validCounts(workers, 0);
+    auto decodeRange = [&](size_t worker, size_t begin, size_t end) {
+        size_t valid = 0;
+        for (size_t i = begin; i < end; ++i) {
+            out[i] = PayloadData{};
+            entry->project(frames[i].data(), out[i]);
+            valid += out[i].isValid ? 1 : 0;
         }
+        validCounts[worker] = valid;
+    };
+
+    const size_t chunk = (frames.size() + workers - 1) / workers;
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w) {
+        size_t begin = std::min(frames.size(), w * chunk);
+        size_t end = std::min(frames.size(), begin + chunk);
+        pool.emplace_back(decodeRange, w, begin, end);
+    }
+    decodeRange(0, 0, std::min(frames.size(), chunk));
+    for (auto& t : pool) t.join();
 
-        // ===== [22..37] I2C SENSOR BLOCK =====
-        payload.radio.sweepCount = b[PayloadIndex::RADIO_SWEEP_COUNT];
-
-        // AHT20 Humidity: 20-bit raw -> RH%
-        uint32_t rawHum = (static_cast<uint32_t>(b[PayloadIndex::AHT20_HUM_0]) << 16) |
-                          (static_cast<uint32_t>(b[PayloadIndex::AHT20_HUM_1]) <<  8) |
-                           static_cast<uint32_t>(b[PayloadIndex::AHT20_HUM_2]);
-        payload.aht20.humidityRH = (rawHum * 100.0f) / SensorCal::AHT20_DIVISOR;
-
-        // AHT20 Temperature: 20-bit raw -> C
-        uint32_t rawTemp = (static_cast<uint32_t>(b[PayloadIndex::AHT20_TEMP_0]) << 16) |
-                           (static_cast<uint32_t>(b[PayloadIndex::AHT20_TEMP_1]) <<  8) |
-                            static_cast<uint32_t>(b[PayloadIndex::AHT20_TEMP_2]);
-        payload.aht20.tempC = (rawTemp * 200.0f / SensorCal::AHT20_DIVISOR) - 50.0f;
-        payload.aht20.tempF = payload.aht20.tempC * 9.0f / 5.0f + 32.0f;
-        payload.aht20.status = b[PayloadIndex::AHT20_STATUS];
-        payload.aht20.isValid = (payload.aht20.status == 2);
-
-        logger.log(LOG_INFO, "  AHT20: " + std::to_string(payload.aht20.humidityRH) + "% RH, " +
-            std::to_string(payload.aht20.tempC) + " C (" + std::to_string(payload.aht20.tempF) +
-            " F) [" + payload.aht20.statusString() + "]");
-
-        // Radio scanner — current station
-        payload.radio.stationIndex = (static_cast<uint16_t>(b[PayloadIndex::RADIO_STATION_MSB]) << 8) |
-                                      static_cast<uint16_t>(b[PayloadIndex::RADIO_STATION_LSB]);
-        payload.radio.frequencyMHz = SensorCal::RADIO_BASE_MHZ +
-                                     (payload.radio.stationIndex * SensorCal::RADIO_STEP_MHZ);
-        payload.radio.signalStrength = b[PayloadIndex::RADIO_SIGNAL];
-        payload.radio.stereo = (b[PayloadIndex::RADIO_STEREO] != 0);
-
-        // Radio scanner — peak signal this sweep
-        payload.radio.peakSignal = b[PayloadIndex::RADIO_PEAK_SIGNAL];
-
-        // MODEM 2.0 — modem code stored in I2C block bytes [14..15]
-        uint16_t i2cModemCode = (static_cast<uint16_t>(b[PayloadIndex::I2C_MODEM_MSB]) << 8) |
-                                 static_cast<uint16_t>(b[PayloadIndex::I2C_MODEM_LSB]);
-        payload.modem.i2cModemCode = i2cModemCode;  // per-record modem code from SEEPROM
-
-        logger.log(LOG_INFO, "  Radio: " + std::to_string(payload.radio.frequencyMHz) +
-            " MHz, signal=" + std::to_string(payload.radio.signalStrength) + "/15" +
-            (payload.radio.stereo ? " STEREO" : " MONO") +
-            " | sweep#=" + std::to_string(payload.radio.sweepCount) +
-            " peakSig=" + std::to_string(payload.radio.peakSignal));
-
-        // ===== [39..46] ANALOG SENSORS =====
-        uint16_t rawMBatt = (static_cast<uint16_t>(b[PayloadIndex::MASTER_BATT_MSB]) << 8) |
-                             static_cast<uint16_t>(b[PayloadIndex::MASTER_BATT_LSB]);
-        payload.masterBattery = decodeMasterBattery(rawMBatt);
-
-        uint16_t rawIntT = (static_cast<uint16_t>(b[PayloadIndex::INT_TEMP_MSB]) << 8) |
-                            static_cast<uint16_t>(b[PayloadIndex::INT_TEMP_LSB]);
-        payload.internalTemp = decodeInternalTemp(rawIntT);
-
-        uint16_t rawExtT = (static_cast<uint16_t>(b[PayloadIndex::EXT_TEMP_MSB]) << 8) |
-                            static_cast<uint16_t>(b[PayloadIndex::EXT_TEMP_LSB]);
-        payload.externalTemp = decodeExternalTemp(rawExtT);
-
-        payload.slaveBattery = decodeSlaveBattery(b[PayloadIndex::SLAVE_BATT_MSB],
-                                                   b[PayloadIndex::SLAVE_BATT_LSB]);
-
-        logger.log(LOG_INFO, "  Master Batt: " + std::to_string(payload.masterBattery.measurement) + " V");
-        logger.log(LOG_INFO, "  Slave Batt:  " + std::to_string(payload.slaveBattery.measurement) + " V");
-        logger.log(LOG_INFO, "  Int Temp:    " + std::to_string(payload.internalTemp.measurement) + " C");
-        logger.log(LOG_INFO, "  Ext Temp:    " + std::to_string(payload.externalTemp.measurement) + " C");
-
-        // ===== MODEM STATUS =====
-        // Full 16-bit current code: MSB at TX[33]=payload[38], LSB at TX[42]=payload[47]
-        uint16_t modemFull = (static_cast<uint16_t>(b[PayloadIndex::MODEM_CURRENT_MSB]) << 8) |
-                              static_cast<uint16_t>(b[PayloadIndex::MODEM_CURRENT_LSB]);
-        payload.modem.currentCode  = modemFull;
-        uint16_t modemPrevFull = (static_cast<uint16_t>(b[PayloadIndex::MODEM_PREVIOUS_MSB]) << 8) |
-                                   static_cast<uint16_t>(b[PayloadIndex::MODEM_PREVIOUS_LSB]);
-        payload.modem.previousCode = modemPrevFull;
-        payload.modem.currentDesc    = getModemStatusDescription(payload.modem.currentCode);
-        payload.modem.previousDesc   = getModemStatusDescription(payload.modem.previousCode);
-
-        logger.log(LOG_INFO, "  Modem: cur=" + std::to_string(payload.modem.currentCode) +
-            " (" + payload.modem.currentDesc + "), prev=" + std::to_string(payload.modem.previousCode) +
-            " (" + payload.modem.previousDesc + ")");
-
-        payload.isValid = payload.headerValid;
+    size_t valid = 0;
+    for (size_t v : validCounts) valid += v;
 
-    } catch (const std::exception& e) {
-        logger.log(LOG_ERROR, "Error decoding hex payload: " + std::string(e.what()));
-        payload.isValid = false;
+    auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ASCEND_LOG(LOG_INFO, "Batch decoded {} frames ({} valid, {}) on {} thread(s) in {} ms",
+        frames.size(), valid, entry->name, workers, ms);
+    return valid;
+}
+
+void Decoder::setLayoutSchedule(std::vector<LayoutRange> schedule) {
+    layoutSchedule_ = std::move(schedule);
+}
+
+TxLayoutVersion Decoder::layoutFor(const std::string& imei, int momsn) const {
+    for (const auto& r : layoutSchedule_) {
+        if ((r.imei.empty() || r.imei == imei) && momsn >= r.firstMomsn && momsn <= r.lastMomsn) {
+            return r.version;
+        }
     }
-    return payload;
+    return TxLayoutVersion::Auto;
 }
 
 // ============================================================
@@ -334,20 +443,18 @@ PayloadData Decoder::decodeHexPayload(const std::string& hexString) {
 
 AnalogSensor Decoder::decodeMasterBattery(uint16_t rawADC) {
     AnalogSensor s;
-    s.name = "Master Battery";
+    s.kind = SensorKind::MasterBattery;
     // Source: analogRead(29) on the RP2040 built-in ADC.
     // ADC_TO_VOLTAGE = 0.00322 V/count; MASTER_BATT_CAL = 0.971 (divider ratio).
     s.voltage = rawADC * SensorCal::ADC_TO_VOLTAGE;
     s.measurement = s.voltage / SensorCal::MASTER_BATT_CAL;
-    s.unit = "V";
     s.isValid = true;
     return s;
 }
 
-AnalogSensor Decoder::decodeSlaveBattery(uint8_t msb, uint8_t lsb) {
+AnalogSensor Decoder::decodeSlaveBattery(uint16_t rawADC) {
     AnalogSensor s;
-    s.name = "Slave Battery";
-    uint16_t rawADC = (static_cast<uint16_t>(msb) << 8) | static_cast<uint16_t>(lsb);
+    s.kind = SensorKind::SlaveBattery;
     // Ground-truth calibration (bench measurement):
     //   raw≈3248 → fdr.ADCconvertToVoltage → Vmeas≈0.609V → actual=6.98V (multimeter)
     //   Slave ADC conversion: 0.609 / 3248 = 0.0001875 V/count
@@ -356,40 +463,39 @@ AnalogSensor Decoder::decodeSlaveBattery(uint8_t msb, uint8_t lsb) {
     // The old formula (FDR_ADC_TO_VOLTAGE × 1.049) gave ~0.63V — incorrect.
     s.voltage     = rawADC * SensorCal::SLAVE_ADC_TO_VOLTAGE;         // Vmeasured at ADC pin
     s.measurement = rawADC * SensorCal::SLAVE_BATT_VOLT_PER_COUNT;    // true battery voltage
-    s.unit = "V";
     s.isValid = true;
     return s;
 }
 
 AnalogSensor Decoder::decodeInternalTemp(uint16_t rawADC) {
     AnalogSensor s;
-    s.name = "Internal Temperature";
+    s.kind = SensorKind::InternalTemp;
     // Source: fdr.ADCread(ADC_PORT_INT_TEMP) — external fdr ADC chip.
     // Must use FDR_ADC_TO_VOLTAGE, NOT ADC_TO_VOLTAGE.
     // Using ADC_TO_VOLTAGE (0.00322) inflated voltage ~19× → ~1200°C instead of ~22°C.
     s.voltage = rawADC * SensorCal::FDR_ADC_TO_VOLTAGE;
-    float tempC = (s.voltage - SensorCal::INT_TEMP_OFFSET_V) / SensorCal::TEMP_SCALE_VPDC;
-    float tempF = tempC * 1.8f + 32.0f;
-    s.measurement = tempC;
-    s.unit = "°C (" + std::to_string(static_cast<int>(tempF)) + "°F)";
+    s.measurement = (s.voltage - SensorCal::INT_TEMP_OFFSET_V) / SensorCal::TEMP_SCALE_VPDC;
     s.isValid = true;
     return s;
 }
 
 AnalogSensor Decoder::decodeExternalTemp(uint16_t rawADC) {
     AnalogSensor s;
-    s.name = "External Temperature";
+    s.kind = SensorKind::ExternalTemp;
     // Source: fdr.ADCread(ADC_PORT_EXT_TEMP) — external fdr ADC chip.
     // Same fix as decodeInternalTemp: must use FDR_ADC_TO_VOLTAGE, not ADC_TO_VOLTAGE.
     s.voltage = rawADC * SensorCal::FDR_ADC_TO_VOLTAGE;
-    float tempC = (s.voltage - SensorCal::EXT_TEMP_OFFSET_V) / SensorCal::TEMP_SCALE_VPDC;
-    float tempF = tempC * 1.8f + 32.0f;
-    s.measurement = tempC;
-    s.unit = "°C (" + std::to_string(static_cast<int>(tempF)) + "°F)";
+    s.measurement = (s.voltage - SensorCal::EXT_TEMP_OFFSET_V) / SensorCal::TEMP_SCALE_VPDC;
     s.isValid = true;
     return s;
 }
 
+std::string AnalogSensor::unitString() const {
+    if (unit() == SensorUnit::Volts) return "V";
+    const float tempF = measurement * 1.8f + 32.0f;
+    return "°C (" + std::to_string(static_cast<int>(tempF)) + "°F)";
+}
+
 // ============================================================
 //   MODEM STATUS DESCRIPTIONS
 //
@@ -406,174 +512,202 @@ AnalogSensor Decoder::decodeExternalTemp(uint16_t rawADC) {
 //   All descriptions are now keyed on the real full code value.
 // ============================================================
 
+namespace {
+
+struct ModemStatusText {
+    uint16_t code;
+    std::string_view text;
+};
+
+// Sorted by code for binary search
+constexpr ModemStatusText MODEM_STATUS_TEXT[] = {
+    // ── Iridium MO Status Codes (hardware, 0-65) ──────────────────────
+    { 0,     "MO transfer successful" },
+    { 1,     "MO success — MT message too large to transfer" },
+    { 2,     "MO success — Location Update not accepted" },
+    { 3,     "Reserved (MO success)" },
+    { 4,     "Reserved (MO success)" },
+    { 5,     "Reserved (MO failure)" },
+    { 6,     "Reserved (MO failure)" },
+    { 7,     "Reserved (MO failure)" },
+    { 8,     "Reserved (MO failure)" },
+    { 10,    "GSS: call did not complete in allowed time" },
+    { 11,    "GSS: MO message queue full" },
+    { 12,    "GSS: MO message has too many segments" },
+    { 13,    "GSS: session did not complete" },
+    { 14,    "GSS: invalid segment size" },
+    { 15,    "GSS: access denied" },
+    { 16,    "ISU locked — cannot make SBD calls" },
+    { 17,    "Gateway not responding (local session timeout)" },
+    { 18,    "Connection lost (RF drop)" },
+    { 19,    "Link failure (protocol error)" },
+    { 32,    "No network service — unable to initiate call" },
+    { 33,    "Antenna fault — unable to initiate call" },
+    { 34,    "Radio disabled — unable to initiate call" },
+    { 35,    "ISU busy — unable to initiate call" },
+    { 36,    "Try later — must wait 3 min since last registration" },
+    { 37,    "SBD service temporarily disabled" },
+    { 38,    "Try later — traffic management period" },
+    { 64,    "Band violation — transmit outside permitted band" },
+    { 65,    "PLL lock failure — hardware error during transmit" },
+
+    // ── Library Failure Codes (100-299) ───────────────────────────────
+    { 100,   "Failure after SBDIX" },
+    { 101,   "Modem status timed out" },
+    { 104,   "Unexpected MO status value" },
+    { 105,   "Unexpected MOMSN value" },
+    { 106,   "Unexpected MT status value" },
+    { 107,   "Unexpected MTMSN status value" },
+    { 108,   "Unexpected MT SBD message length" },
+    { 109,   "Unexpected MT SBD message queued value" },
+    { 112,   "Modem failure after SBDIX" },
+    { 113,   "Unexpected response to SBDIX" },
+    { 114,   "Timeout after SBDIX" },
+    { 116,   "Timeout after sending message size" },
+    { 118,   "MO buffer cleared — error response" },
+    { 119,   "MO buffer cleared — timed out" },
+    { 120,   "Invalid command" },
+    { 200,   "MO buffer cleared — unexpected response" },
+    { 202,   "MT buffer cleared — error response" },
+    { 203,   "MT buffer cleared — timed out" },
+    { 204,   "MT buffer cleared — unexpected response" },
+    { 206,   "Disable flow control — timed out" },
+    { 207,   "Disable flow control — unexpected response" },
+    { 208,   "Disable SBD ring setup — timed out" },
+    { 209,   "Disable SBD ring setup — unexpected response" },
+    { 231,   "Ring indication erroneously enabled" },
+    { 232,   "Timeout waiting for verify-disable MT alert" },
+    { 233,   "Unexpected response to SBDMTA" },
+    { 234,   "Unexpected response after sending message size" },
+    { 236,   "Setup failed — timed out" },
+    { 237,   "Setup failed — unexpected response" },
+    { 238,   "Network status — unexpected response" },
+    { 239,   "Network status — timed out (no valid response)" },
+    { 240,   "Network not available" },
+    { 242,   "MT message — unexpected response" },
+    { 243,   "MT message — timed out" },
+    { 244,   "MT message — failed checksum" },
+    { 245,   "MT message too long" },
+    { 249,   "Modem setup failed — timed out" },
+    { 250,   "No modem connected" },
+    { 251,   "Unexpected modem connected" },
+    { 255,   "Duplicate transmit attempted" },
+    { 256,   "Transmit requested too soon — try later" },
+    { 257,   "Flow control setup — timed out" },
+    { 258,   "Flow control setup — unexpected response" },
+    { 259,   "Store configuration — timed out" },
+    { 260,   "Store configuration — unexpected response" },
+    { 261,   "Select profile — timed out" },
+    { 262,   "Select profile — unexpected response" },
+    { 263,   "Ring indication — unexpected response" },
+    { 264,   "OK search timed out" },
+    { 265,   "OK — unexpected response" },
+    { 269,   "Signal strength too low" },
+    { 272,   "Transmit successful but receive failed" },
+    { 273,   "Unexpected modem command" },
+    { 274,   "MPM busy — transmit command rejected" },
+    { 275,   "Ping to MPM timed out" },
+    { 276,   "Ping to MPM success but ping to modem failed" },
+    { 278,   "Initial setup modem status value" },
+    { 279,   "Timeout waiting for receive data" },
+    { 280,   "No ping — MPM busy" },
+    { 282,   "Unexpected response from modem during setup" },
+    { 283,   "Modem setup failed — MPM busy" },
+    { 284,   "Modem failed at setup — timed out" },
+    { 285,   "MPM busy when FDR asked for setup" },
+    { 286,   "MPM did not respond to request for data" },
+    { 287,   "Software error 1" },
+    { 288,   "MPM busy" },
+    { 289,   "Asked for ping result too soon — do ping again" },
+    { 290,   "Ping to MPM did not respond" },
+    { 291,   "Wrong modem connected — check serial number" },
+    { 292,   "Requested transmit too soon" },
+    { 293,   "No functioning modem present" },
+    { 294,   "Timeout after sending message" },
+    { 295,   "SBD message timed out by modem" },
+    { 296,   "SBD message checksum wrong" },
+    { 297,   "SBD message size wrong" },
+    { 298,   "Unexpected response after writing to MO buffer" },
+    { 299,   "SBD message size too big or too small" },
+
+    // ── Library Status Codes (300-399) ────────────────────────────────
+    { 300,   "Success byte after SBDIX" },
+    { 301,   "Message size accepted" },
+    { 302,   "MO buffer cleared successfully" },
+    { 303,   "MT buffer cleared successfully" },
+    { 304,   "OK found" },
+    { 305,   "Ring indication disabled" },
+    { 306,   "Setup successful" },
+    { 307,   "MT message retrieved correctly" },
+    { 308,   "MT message is null" },
+    { 309,   "Modem setup successful" },
+    { 310,   "Correct modem connected" },
+    { 313,   "Network available — acceptable signal strength" },
+    { 314,   "Verify disable MT alert" },
+    { 315,   "Flushed UART buffer" },
+    { 316,   "Array sent to modem" },
+    { 317,   "Initiate transmit and receive" },
+    { 318,   "Tell modem to clear MO buffer" },
+    { 319,   "Tell modem to clear MT buffer" },
+    { 320,   "Told modem to give us the received message" },
+    { 322,   "Transmission process has begun" },
+    { 323,   "Sent PerformTransmit" },
+    { 324,   "Sent getReceivedData" },
+    { 326,   "About to start transmit process" },
+    { 327,   "Waiting for OK from modem" },
+    { 330,   "Busy setting up modem" },
+    { 331,   "Performing ping" },
+    { 333,   "Ping not running" },
+    { 334,   "MPM busy — transmit command pending" },
+    { 335,   "Modem setup proceeding" },
+    { 336,   "Modem defaults set" },
+    { 337,   "Sent ping" },
+    { 338,   "SBD message successfully written" },
+    { 339,   "MT message pending" },
+    { 340,   "MT messages pending" },
+
+    // ── Library Success Codes (400-499) ───────────────────────────────
+    { 400,   "Ping through MPM and modem — success" },
+    { 401,   "Modem ready for use" },
+    { 402,   "Transmit successful — no receive" },
+    { 403,   "Transmit and receive successful" },
+    { 404,   "TX+RX successful — receive pending" },
+    { 405,   "Data loop-around enabled" },
+    { 406,   "Data loop-around disabled" },
+    { 407,   "Receive data placed in receive array" },
+
+    { 0xFFFF, "No status yet" },
+};
+
+static_assert(std::is_sorted(std::begin(MODEM_STATUS_TEXT), std::end(MODEM_STATUS_TEXT),
+    [](const ModemStatusText& a, const ModemStatusText& b) { return a.code < b.code; }),
+    "MODEM_STATUS_TEXT must be sorted by code");
+
+} // namespace
+
+std::string_view Decoder::modemStatusText(uint16_t code) {
+    auto it = std::lower_bound(std::begin(MODEM_STATUS_TEXT), std::end(MODEM_STATUS_TEXT), code,
+        [](const ModemStatusText& e, uint16_t c) { return e.code < c; });
+    return (it != std::end(MODEM_STATUS_TEXT) && it->code == code) ? it->text : std::string_view{};
+}
+
 std::string Decoder::getModemStatusDescription(uint16_t code) {
-    switch (code) {
-
-        // ── Iridium MO Status Codes (hardware, 0-65) ──────────────────────
-        case 0:   return "MO transfer successful";
-        case 1:   return "MO success — MT message too large to transfer";
-        case 2:   return "MO success — Location Update not accepted";
-        case 3:   return "Reserved (MO success)";
-        case 4:   return "Reserved (MO success)";
-        case 5:   return "Reserved (MO failure)";
-        case 6:   return "Reserved (MO failure)";
-        case 7:   return "Reserved (MO failure)";
-        case 8:   return "Reserved (MO failure)";
-        case 10:  return "GSS: call did not complete in allowed time";
-        case 11:  return "GSS: MO message queue full";
-        case 12:  return "GSS: MO message has too many segments";
-        case 13:  return "GSS: session did not complete";
-        case 14:  return "GSS: invalid segment size";
-        case 15:  return "GSS: access denied";
-        case 16:  return "ISU locked — cannot make SBD calls";
-        case 17:  return "Gateway not responding (local session timeout)";
-        case 18:  return "Connection lost (RF drop)";
-        case 19:  return "Link failure (protocol error)";
-        case 32:  return "No network service — unable to initiate call";
-        case 33:  return "Antenna fault — unable to initiate call";
-        case 34:  return "Radio disabled — unable to initiate call";
-        case 35:  return "ISU busy — unable to initiate call";
-        case 36:  return "Try later — must wait 3 min since last registration";
-        case 37:  return "SBD service temporarily disabled";
-        case 38:  return "Try later — traffic management period";
-        case 64:  return "Band violation — transmit outside permitted band";
-        case 65:  return "PLL lock failure — hardware error during transmit";
-
-        // ── Library Failure Codes (100-299) ───────────────────────────────
-        case 100: return "Failure after SBDIX";
-        case 101: return "Modem status timed out";
-        case 104: return "Unexpected MO status value";
-        case 105: return "Unexpected MOMSN value";
-        case 106: return "Unexpected MT status value";
-        case 107: return "Unexpected MTMSN status value";
-        case 108: return "Unexpected MT SBD message length";
-        case 109: return "Unexpected MT SBD message queued value";
-        case 112: return "Modem failure after SBDIX";
-        case 113: return "Unexpected response to SBDIX";
-        case 114: return "Timeout after SBDIX";
-        case 116: return "Timeout after sending message size";
-        case 118: return "MO buffer cleared — error response";
-        case 119: return "MO buffer cleared — timed out";
-        case 120: return "Invalid command";
-        case 200: return "MO buffer cleared — unexpected response";
-        case 202: return "MT buffer cleared — error response";
-        case 203: return "MT buffer cleared — timed out";
-        case 204: return "MT buffer cleared — unexpected response";
-        case 206: return "Disable flow control — timed out";
-        case 207: return "Disable flow control — unexpected response";
-        case 208: return "Disable SBD ring setup — timed out";
-        case 209: return "Disable SBD ring setup — unexpected response";
-        case 231: return "Ring indication erroneously enabled";
-        case 232: return "Timeout waiting for verify-disable MT alert";
-        case 233: return "Unexpected response to SBDMTA";
-        case 234: return "Unexpected response after sending message size";
-        case 236: return "Setup failed — timed out";
-        case 237: return "Setup failed — unexpected response";
-        case 238: return "Network status — unexpected response";
-        case 239: return "Network status — timed out (no valid response)";
-        case 240: return "Network not available";
-        case 242: return "MT message — unexpected response";
-        case 243: return "MT message — timed out";
-        case 244: return "MT message — failed checksum";
-        case 245: return "MT message too long";
-        case 249: return "Modem setup failed — timed out";
-        case 250: return "No modem connected";
-        case 251: return "Unexpected modem connected";
-        case 255: return "Duplicate transmit attempted";
-        case 256: return "Transmit requested too soon — try later";
-        case 257: return "Flow control setup — timed out";
-        case 258: return "Flow control setup — unexpected response";
-        case 259: return "Store configuration — timed out";
-        case 260: return "Store configuration — unexpected response";
-        case 261: return "Select profile — timed out";
-        case 262: return "Select profile — unexpected response";
-        case 263: return "Ring indication — unexpected response";
-        case 264: return "OK search timed out";
-        case 265: return "OK — unexpected response";
-        case 269: return "Signal strength too low";
-        case 272: return "Transmit successful but receive failed";
-        case 273: return "Unexpected modem command";
-        case 274: return "MPM busy — transmit command rejected";
-        case 275: return "Ping to MPM timed out";
-        case 276: return "Ping to MPM success but ping to modem failed";
-        case 278: return "Initial setup modem status value";
-        case 279: return "Timeout waiting for receive data";
-        case 280: return "No ping — MPM busy";
-        case 282: return "Unexpected response from modem during setup";
-        case 283: return "Modem setup failed — MPM busy";
-        case 284: return "Modem failed at setup — timed out";
-        case 285: return "MPM busy when FDR asked for setup";
-        case 286: return "MPM did not respond to request for data";
-        case 287: return "Software error 1";
-        case 288: return "MPM busy";
-        case 289: return "Asked for ping result too soon — do ping again";
-        case 290: return "Ping to MPM did not respond";
-        case 291: return "Wrong modem connected — check serial number";
-        case 292: return "Requested transmit too soon";
-        case 293: return "No functioning modem present";
-        case 294: return "Timeout after sending message";
-        case 295: return "SBD message timed out by modem";
-        case 296: return "SBD message checksum wrong";
-        case 297: return "SBD message size wrong";
-        case 298: return "Unexpected response after writing to MO buffer";
-        case 299: return "SBD message size too big or too small";
-
-        // ── Library Status Codes (300-399) ────────────────────────────────
-        case 300: return "Success byte after SBDIX";
-        case 301: return "Message size accepted";
-        case 302: return "MO buffer cleared successfully";
-        case 303: return "MT buffer cleared successfully";
-        case 304: return "OK found";
-        case 305: return "Ring indication disabled";
-        case 306: return "Setup successful";
-        case 307: return "MT message retrieved correctly";
-        case 308: return "MT message is null";
-        case 309: return "Modem setup successful";
-        case 310: return "Correct modem connected";
-        case 313: return "Network available — acceptable signal strength";
-        case 314: return "Verify disable MT alert";
-        case 315: return "Flushed UART buffer";
-        case 316: return "Array sent to modem";
-        case 317: return "Initiate transmit and receive";
-        case 318: return "Tell modem to clear MO buffer";
-        case 319: return "Tell modem to clear MT buffer";
-        case 320: return "Told modem to give us the received message";
-        case 322: return "Transmission process has begun";
-        case 323: return "Sent PerformTransmit";
-        case 324: return "Sent getReceivedData";
-        case 326: return "About to start transmit process";
-        case 327: return "Waiting for OK from modem";
-        case 330: return "Busy setting up modem";
-        case 331: return "Performing ping";
-        case 333: return "Ping not running";
-        case 334: return "MPM busy — transmit command pending";
-        case 335: return "Modem setup proceeding";
-        case 336: return "Modem defaults set";
-        case 337: return "Sent ping";
-        case 338: return "SBD message successfully written";
-        case 339: return "MT message pending";
-        case 340: return "MT messages pending";
-
-        // ── Library Success Codes (400-499) ───────────────────────────────
-        case 400: return "Ping through MPM and modem — success";
-        case 401: return "Modem ready for use";
-        case 402: return "Transmit successful — no receive";
-        case 403: return "Transmit and receive successful";
-        case 404: return "TX+RX successful — receive pending";
-        case 405: return "Data loop-around enabled";
-        case 406: return "Data loop-around disabled";
-        case 407: return "Receive data placed in receive array";
-
-        case 0xFFFF: return "No status yet";
-        default: {
-            if (code >= 20  && code <= 31)  return "Reserved (MO failure range 20-31)";
-            if (code >= 39  && code <= 63)  return "Reserved (MO failure range 39-63)";
-            if (code >= 300 && code <= 399) return "Status code " + std::to_string(code);
-            if (code >= 400 && code <= 499) return "Success code " + std::to_string(code);
-            if (code >= 100 && code <= 299) return "Failure code " + std::to_string(code);
-            return "Unknown code " + std::to_string(code);
-        }
-    }
+    std::string_view text = modemStatusText(code);
+    if (!text.empty()) return std::string(text);
+    if (code >= 20  && code <= 31)  return "Reserved (MO failure range 20-31)";
+    if (code >= 39  && code <= 63)  return "Reserved (MO failure range 39-63)";
+    if (code >= 300 && code <= 399) return "Status code " + std::to_string(code);
+    if (code >= 400 && code <= 499) return "Success code " + std::to_string(code);
+    if (code >= 100 && code <= 299) return "Failure code " + std::to_string(code);
+    return "Unknown code " + std::to_string(code);
+}
+
+std::string ModemInfo::currentDesc() const {
+    return Decoder::getModemStatusDescription(currentCode);
+}
+
+std::string ModemInfo::previousDesc() const {
+    return Decoder::getModemStatusDescription(previousCode);
 }
 
 // ============================================================
@@ -583,12 +717,19 @@ std::string Decoder::getModemStatusDescription(uint16_t code) {
 std::string PayloadData::toString() const {
     std::stringstream ss;
     ss << std::fixed << std::setprecision(2);
-    ss << " DECODED PAYLOAD (v4.2.4 — 50 byte frame: 5 mfr + 45 TX)\n";
-    ss << "Header:          " << header << (headerValid ? " Valid" : " Not Valid") << "\n";
+    ss << " DECODED PAYLOAD (" << FrameRegistry::versionName(layout) << " — 50 byte frame: 5 mfr + 45 TX)\n";
+    ss << "Header:          " << headerText() << (headerValid ? " Valid" : " Not Valid") << "\n";
     ss << "Serial Number:   " << serialNumber << "\n";
-    ss << "BT Datalink:     " << (btLinkGood ? "GOOD" : "BAD")
-       << "  (raw=0x" << std::hex << std::uppercase << std::setw(2) << std::setfill('0')
-       << (int)datalinkByte << std::dec << ")\n";
+    if (layout == TxLayoutVersion::V4_1) {
+        ss << "Flight Status:   " << flightStatus.getPhaseString()
+           << "  (raw=0x" << std::hex << std::uppercase << std::setw(2) << std::setfill('0')
+           << (int)flightStatus.raw << std::dec << std::setfill(' ') << ")\n";
+        ss << "Record Seq:      " << (int)recordSequence << "\n";
+    } else {
+        ss << "BT Datalink:     " << (btLinkGood ? "GOOD" : "BAD")
+           << "  (raw=0x" << std::hex << std::uppercase << std::setw(2) << std::setfill('0')
+           << (int)datalinkByte << std::dec << std::setfill(' ') << ")\n";
+    }
 
     ss << "\nGNSS: " << (gnssValid ? "(VALID)" : "(INVALID — junk data)") << "\n";
     ss << "  UTC:       " << (int)utcHours << ":" << (int)utcMinutes << ":" << (int)utcSeconds << "\n";
@@ -598,7 +739,7 @@ std::string PayloadData::toString() const {
     ss << "  Longitude: " << longitude << " ("
        << (int)longitudeDMS.degrees << "d " << (int)longitudeDMS.minutes << "' "
        << (int)longitudeDMS.seconds << "\" " << longitudeDMS.hemisphere << ")\n";
-    ss << "  Altitude:  " << altitude << " " << altitudeUnits << "\n";
+    ss << "  Altitude:  " << altitude << " " << altitudeUnitName(altitudeUnits) << "\n";
 
     ss << "\nI2C Sensors:\n";
     ss << "  AHT20:     " << aht20.humidityRH << "% RH, "
@@ -606,18 +747,20 @@ std::string PayloadData::toString() const {
     ss << "  Radio:     " << radio.frequencyMHz << " MHz, signal "
        << (int)radio.signalStrength << "/15 " << (radio.stereo ? "STEREO" : "MONO")
        << "  sweep#=" << (int)radio.sweepCount << "\n";
-    ss << "  Radio Peak: " << radio.peakFrequencyMHz << " MHz, signal "
-       << (int)radio.peakSignal << "/15\n";
+    ss << "  Radio Peak: signal " << (int)radio.peakSignal << "/15\n";
 
     ss << "\nAnalog Sensors:\n";
-    ss << "  " << masterBattery.name << ": " << masterBattery.measurement << " " << masterBattery.unit << "\n";
-    ss << "  " << slaveBattery.name  << ": " << slaveBattery.measurement  << " " << slaveBattery.unit << "\n";
-    ss << "  " << internalTemp.name  << ": " << internalTemp.measurement  << " " << internalTemp.unit << "\n";
-    ss << "  " << externalTemp.name  << ": " << externalTemp.measurement  << " " << externalTemp.unit << "\n";
+    ss << "  " << masterBattery.name() << ": " << masterBattery.measurement << " " << masterBattery.unitString() << "\n";
+    ss << "  " << slaveBattery.name()  << ": " << slaveBattery.measurement  << " " << slaveBattery.unitString() << "\n";
+    ss << "  " << internalTemp.name()  << ": " << internalTemp.measurement  << " " << internalTemp.unitString() << "\n";
+    ss << "  " << externalTemp.name()  << ": " << externalTemp.measurement  << " " << externalTemp.unitString() << "\n";
 
     ss << "\nModem:\n";
-    ss << "  Current:   " << modem.currentCode << " — " << modem.currentDesc << "\n";
-    ss << "  Previous:  " << modem.previousCode << " — " << modem.previousDesc << "\n";
+    ss << "  Current:   " << modem.currentCode << " — " << modem.currentDesc() << "\n";
+    ss << "  Previous:  " << modem.previousCode << " — " << modem.previousDesc() << "\n";
+    if (layout == TxLayoutVersion::V4_1) {
+        ss << "  TX Success: " << (int)modem.txSuccessCount << "\n";
+    }
 
     return ss.str();
 }
@@ -0,0 +1,241 @@
+#include "FrameRegistry.h"
+#include <array>
+
+namespace {
+
+// ============================================================
+//   SHARED BLOCKS — identical offsets in every revision so far
+// ============================================================
+
+template <typename Raw>
+void projectHeader(const Raw& raw, PayloadData& p) {
+    p.header = { static_cast<char>(raw.header >> 8), static_cast<char>(raw.header & 0xFF) };
+    p.headerValid  = (p.headerText() == "RB");
+    p.serialNumber = raw.serialNumber;
+}
+
+// The BT slave can send junk data. Every field is still filled in, but
+// gnssValid is only set if ALL checks pass; failed checks are recorded in
+// gnssFaults for the log.
+template <typename Raw>
+void projectGnss(const Raw& raw, PayloadData& p) {
+    p.utcHours   = raw.utcHours;
+    p.utcMinutes = raw.utcMinutes;
+    p.utcSeconds = raw.utcSeconds;
+
+    p.latitudeDMS.degrees    = raw.latDegrees;
+    p.latitudeDMS.minutes    = raw.latMinutes;
+    p.latitudeDMS.seconds    = raw.latSeconds;
+    p.latitudeDMS.hemisphere = (raw.latHemisphere == 0) ? 'N' : 'S';
+    p.latitudeDMS.hemisphereByte = raw.latHemisphere;
+    p.latitude = p.latitudeDMS.degrees
+               + (p.latitudeDMS.minutes / 60.0)
+               + (p.latitudeDMS.seconds / 3600.0);
+    if (p.latitudeDMS.hemisphere == 'S') p.latitude = -p.latitude;
+
+    p.longitudeDMS.degrees    = raw.lonDegrees;
+    p.longitudeDMS.minutes    = raw.lonMinutes;
+    p.longitudeDMS.seconds    = raw.lonSeconds;
+    p.longitudeDMS.hemisphere = (raw.lonHemisphere == 0) ? 'E' : 'W';
+    p.longitudeDMS.hemisphereByte = raw.lonHemisphere;
+    p.longitude = p.longitudeDMS.degrees
+                + (p.longitudeDMS.minutes / 60.0)
+                + (p.longitudeDMS.seconds / 3600.0);
+    if (p.longitudeDMS.hemisphere == 'W') p.longitude = -p.longitude;
+
+    p.altitude = static_cast<int32_t>(raw.altitude);
+    p.altitudeUnits = (raw.altitudeUnits == 0) ? AltitudeUnit::Meters : AltitudeUnit::Feet;
+    p.altitudeUnitsByte = raw.altitudeUnits;
+
+    uint16_t f = 0;
+    if (p.utcHours > 23)                f |= GnssFault::UTC_HOURS;
+    if (p.utcMinutes > 59)              f |= GnssFault::UTC_MINUTES;
+    if (p.utcSeconds > 59)              f |= GnssFault::UTC_SECONDS;
+    if (p.latitudeDMS.degrees > 90)     f |= GnssFault::LAT_DEGREES;
+    if (p.latitudeDMS.minutes > 59)     f |= GnssFault::LAT_MINUTES;
+    if (p.latitudeDMS.seconds > 59)     f |= GnssFault::LAT_SECONDS;
+    if (p.longitudeDMS.degrees > 180)   f |= GnssFault::LON_DEGREES;
+    if (p.longitudeDMS.minutes > 59)    f |= GnssFault::LON_MINUTES;
+    if (p.longitudeDMS.seconds > 59)    f |= GnssFault::LON_SECONDS;
+    if (raw.latHemisphere > 1)          f |= GnssFault::LAT_HEMISPHERE;
+    if (raw.lonHemisphere > 1)          f |= GnssFault::LON_HEMISPHERE;
+    if (raw.altitudeUnits > 1)          f |= GnssFault::ALT_UNITS;
+    // Reject obviously absurd values (> 50,000 m or < -1000 m)
+    if (p.altitude > 50000 || p.altitude < -1000) f |= GnssFault::ALT_RANGE;
+    // All-zero GNSS block means no lock
+    if (p.utcHours == 0 && p.utcMinutes == 0 && p.utcSeconds == 0 &&
+        p.latitudeDMS.degrees == 0 && p.latitudeDMS.minutes == 0 &&
+        p.longitudeDMS.degrees == 0 && p.longitudeDMS.minutes == 0) f |= GnssFault::NO_LOCK;
+    p.gnssFaults = f;
+    p.gnssValid  = (f == 0);
+}
+
+template <typename Raw>
+void projectAht20AndRadio(const Raw& raw, PayloadData& p) {
+    // AHT20: 20-bit raw -> RH% and C
+    p.aht20.humidityRH = (raw.aht20Humidity * 100.0f) / SensorCal::AHT20_DIVISOR;
+    p.aht20.tempC = (raw.aht20Temp * 200.0f / SensorCal::AHT20_DIVISOR) - 50.0f;
+    p.aht20.tempF = p.aht20.tempC * 9.0f / 5.0f + 32.0f;
+    p.aht20.status = raw.aht20Status;
+    p.aht20.isValid = (p.aht20.status == 2);
+
+    // Radio scanner — current station
+    p.radio.stationIndex = raw.radioStation;
+    p.radio.frequencyMHz = SensorCal::RADIO_BASE_MHZ + (p.radio.stationIndex * SensorCal::RADIO_STEP_MHZ);
+    p.radio.signalStrength = raw.radioSignal;
+    p.radio.stereo = (raw.radioStereo != 0);
+}
+
+// ============================================================
+//   v4.2.4
+// ============================================================
+
+void projectV424(const uint8_t* frame, PayloadData& p) {
+    const RawFrameV424 raw = TxLayoutV424::decode(frame);
+    p.layout = TxLayoutVersion::V4_2_4;
+
+    projectHeader(raw, p);
+    p.datalinkByte = raw.datalinkByte;
+    p.btLinkGood   = (raw.datalinkByte == 0);
+
+    projectGnss(raw, p);
+    projectAht20AndRadio(raw, p);
+    p.radio.sweepCount = raw.radioSweepCount;
+    p.radio.peakSignal = raw.radioPeakSignal;
+
+    p.masterBattery = Decoder::decodeMasterBattery(raw.masterBattery);
+    p.internalTemp  = Decoder::decodeInternalTemp(raw.internalTemp);
+    p.externalTemp  = Decoder::decodeExternalTemp(raw.externalTemp);
+    p.slaveBattery  = Decoder::decodeSlaveBattery(raw.slaveBattery);
+
+    // Full 16-bit current code: MSB at TX[33]=payload[38], LSB at TX[42]=payload[47]
+    p.modem.currentCode  = static_cast<uint16_t>((raw.modemCurrentMsb << 8) | raw.modemCurrentLsb);
+    p.modem.previousCode = raw.modemPreviousCode;
+    p.modem.i2cModemCode = raw.i2cModemCode;  // per-record modem code from SEEPROM
+
+    p.isValid = p.headerValid;
+}
+
+// ============================================================
+//   v4.1 (legacy)
+// ============================================================
+
+void projectV41(const uint8_t* frame, PayloadData& p) {
+    const RawFrameV41 raw = TxLayoutV41::decode(frame);
+    p.layout = TxLayoutVersion::V4_1;
+
+    projectHeader(raw, p);
+    p.flightStatus   = FlightStatus::fromRaw(raw.flightStatus);
+    p.recordSequence = raw.recordSequence;
+
+    projectGnss(raw, p);
+    projectAht20AndRadio(raw, p);
+
+    p.masterBattery = Decoder::decodeMasterBattery(raw.masterBattery);
+    p.internalTemp  = Decoder::decodeInternalTemp(raw.internalTemp);
+    p.externalTemp  = Decoder::decodeExternalTemp(raw.externalTemp);
+    // v4.1 flight software scaled the slave battery with the master FDR ADC
+    p.slaveBattery  = Decoder::decodeSlaveBattery(raw.slaveBattery);
+    p.slaveBattery.voltage     = raw.slaveBattery * SensorCal::FDR_ADC_TO_VOLTAGE;
+    p.slaveBattery.measurement = p.slaveBattery.voltage * SensorCal::V41_SLAVE_BATT_SCALE;
+
+    p.modem.currentCode    = raw.modemCurrent;
+    p.modem.previousCode   = raw.modemPrevious;
+    p.modem.txSuccessCount = raw.txSuccessCount;
+
+    p.isValid = p.headerValid;
+}
+
+// ============================================================
+//   TABLES
+// ============================================================
+
+using FrameRegistry::Entry;
+using FrameRegistry::MAX_FRAME_SIZE;
+
+constexpr Entry ENTRIES[] = {
+    { TxLayoutVersion::V4_1,   TxLayoutV41::size,  "v4.1",   projectV41 },
+    { TxLayoutVersion::V4_2_4, TxLayoutV424::size, "v4.2.4", projectV424 },
+};
+
+constexpr size_t VERSION_COUNT = static_cast<size_t>(TxLayoutVersion::Count);
+constexpr int8_t NONE = -1;
+
+static_assert(std::tuple_size_v<FrameBytes> == MAX_FRAME_SIZE, "FrameBytes must hold the largest frame");
+static_assert(TxLayoutV41::size <= MAX_FRAME_SIZE && TxLayoutV424::size <= MAX_FRAME_SIZE,
+              "MAX_FRAME_SIZE must cover every registered layout");
+
+// [version][size] -> ENTRIES index
+constexpr auto BY_VERSION_SIZE = [] {
+    std::array<std::array<int8_t, MAX_FRAME_SIZE + 1>, VERSION_COUNT> t{};
+    for (auto& row : t) row.fill(NONE);
+    for (size_t i = 0; i < std::size(ENTRIES); ++i) {
+        t[static_cast<size_t>(ENTRIES[i].version)][ENTRIES[i].size] = static_cast<int8_t>(i);
+    }
+    return t;
+}();
+
+// [size] -> ENTRIES index of the newest revision with that size
+constexpr auto BY_SIZE = [] {
+    std::array<int8_t, MAX_FRAME_SIZE + 1> t{};
+    t.fill(NONE);
+    for (size_t i = 0; i < std::size(ENTRIES); ++i) {
+        int8_t& slot = t[ENTRIES[i].size];
+        if (slot == NONE || ENTRIES[slot].version < ENTRIES[i].version) slot = static_cast<int8_t>(i);
+    }
+    return t;
+}();
+
+// [version] -> ENTRIES index (first registered size)
+constexpr auto BY_VERSION = [] {
+    std::array<int8_t, VERSION_COUNT> t{};
+    t.fill(NONE);
+    for (size_t i = 0; i < std::size(ENTRIES); ++i) {
+        int8_t& slot = t[static_cast<size_t>(ENTRIES[i].version)];
+        if (slot == NONE) slot = static_cast<int8_t>(i);
+    }
+    return t;
+}();
+
+const Entry* entryAt(int8_t idx) {
+    return idx == NONE ? nullptr : &ENTRIES[idx];
+}
+
+} // namespace
+
+namespace FrameRegistry {
+
+const Entry* find(TxLayoutVersion version, size_t size) {
+    if (version == TxLayoutVersion::Auto) return forSize(size);
+    size_t v = static_cast<size_t>(version);
+    if (v >= VERSION_COUNT || size > MAX_FRAME_SIZE) return nullptr;
+    return entryAt(BY_VERSION_SIZE[v][size]);
+}
+
+const Entry* forSize(size_t size) {
+    if (size > MAX_FRAME_SIZE) return nullptr;
+    return entryAt(BY_SIZE[size]);
+}
+
+const Entry* forVersion(TxLayoutVersion version) {
+    size_t v = static_cast<size_t>(version);
+    if (v >= VERSION_COUNT) return nullptr;
+    return entryAt(BY_VERSION[v]);
+}
+
+const char* versionName(TxLayoutVersion version) {
+    const Entry* e = forVersion(version);
+    return e ? e->name : "auto";
+}
+
+bool parseVersion(std::string_view name, TxLayoutVersion& out) {
+    for (const auto& e : ENTRIES) {
+        if (name == e.name) {
+            out = e.version;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
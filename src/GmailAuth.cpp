@@ -5,21 +5,18 @@
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <sstream>
-#include <curl/curl.h>
 #include "GmailAuth.h"
-#include "Logger.h"
+#include "logger.h"
 
 using json = nlohmann::json; // This library is used to work with json files and makes life much easier!
 
 extern Logger logger; // Have to use Extern to reference an existing Logger instance (declared in main) because I was getting errors initially for having multiple instances.
 // Look at logger.cpp to see the logger file. 
-static size_t WriteCallBack(void* contents, size_t size, size_t nmemb, void * userp) {
-    ((std::string *)userp)->append((char*)contents, size * nmemb); // In order to use the .append() method i need to use -> because it is a string ptr you can also do (*((std::string *)userp)).append()
-    return size * nmemb; 
-}
-GmailAuth::GmailAuth (const std::string clientSecret, const std::string tokenCache) {
+GmailAuth::GmailAuth (const std::string clientSecret, const std::string tokenCache, std::shared_ptr<HttpSession> httpSession, const std::string tokenEndpoint) {
     clientSecretFile = clientSecret; // Constructor method 
     tokenCacheFile = tokenCache;
+    session = httpSession;
+    tokenUrl = tokenEndpoint;
     redirectUrl = "https://localhost:8000";
     tokenExpiry = 0;
     logger.log(LOG_INFO, "GmailAuth Initialized.");
@@ -27,10 +24,10 @@ GmailAuth::GmailAuth (const std::string clientSecret, const std::string tokenCac
 const std::string GmailAuth::getAccessToken() {
     return accessToken;
 }
-const bool GmailAuth::isAuthenticated() {
+bool GmailAuth::isAuthenticated() {
     return !accessToken.empty() && !isTokenExpired(); // Make sure access token is not expired and exists!!
 }
-const bool GmailAuth::isTokenExpired() {
+bool GmailAuth::isTokenExpired() {
     time_t now = time(nullptr); // When you dont want to store a time anywhere you pass a nullptr and just assign a variable to it.
     return now >= (tokenExpiry - 300); // 5 minutes till expiration
 }
@@ -63,65 +60,26 @@ bool GmailAuth::loadClientSecret() { //Method use to read client secret json fil
 }
 std::string GmailAuth::urlEncode(const std::string value) {
     // When adding values to url parameters, they need to be encoded into a special format
-    CURL * curl = curl_easy_init(); // using curl here to make network requests, basically a way to do HTTP requests programmatically
-    // returns a pointer, we pass this pointer to all CURL functions to tell them which requests 
-    if (!curl) { // if curl_easy_init() fails it returns a nullptr
-        return value;
-    }
-    // pass in handler, value as a c string with null terminator, and length of string
-    char * encoded = curl_easy_escape(curl, value.c_str(), value.length());
-    if (!encoded) {
-        curl_easy_cleanup(curl); //free curl handler
-        logger.log(LOG_ERROR, "Tested as !encoded, value: " + value);
-        return value;
-    }
-    std::string result(encoded); // copy the char* ptr to regular string
-    curl_free(encoded); // free encoded memory
-    curl_easy_cleanup(curl); // free curl handler
+    std::string result = session->escape(value);
     logger.log(LOG_INFO, "EncodedURL: " + result);
     return result;
 }
 // Once we have the user authentication code, it is now time to make the token request.
 std::string GmailAuth::makeTokenRequest(const std::string& postData) {
     logger.log(LOG_INFO, "Making token request to Google.");
-    CURL * curl = curl_easy_init();
-    if (!curl){
-        logger.log(LOG_ERROR, "Failed to Initialize CURL");
+    // Goes through the shared session, so refreshes reuse the open TLS connection
+    HttpResponse res = session->post(tokenUrl, postData, {"Content-Type: application/x-www-form-urlencoded"});
+    if (res.curlCode != CURLE_OK) {
+        logger.log(LOG_ERROR, "Curl request Failed: " + res.error);
         return "";
     }
-    std::string response;
-    const char * tokenUrl = "https://oauth2.googleapis.com/token"; // endpoint to recieve token from code.
-    // This is all curl setup code
-    curl_easy_setopt(curl, CURLOPT_URL, tokenUrl); 
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postData.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallBack);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response); // Store Response in std::string response
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L); 
-
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, "Content-Type: application/x-www-form-urlencoded");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    // execute the request
-    CURLcode res = curl_easy_perform(curl);
-    if (res != CURLE_OK) {
-        logger.log(LOG_ERROR, "Curl request Failed: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        return "";
-    }
-    // get the response and store http code
-    long int httpCode = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-    logger.log(LOG_INFO, "HTTP Status: " + std::to_string(httpCode));
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-    if (httpCode != 200) {
-        logger.log(LOG_ERROR, "HTTP error " + std::to_string(httpCode));
-        logger.log(LOG_ERROR, "Response: " + response);
+    logger.log(LOG_INFO, "HTTP Status: " + std::to_string(res.status));
+    if (res.status != 200) {
+        logger.log(LOG_ERROR, "HTTP error " + std::to_string(res.status));
+        logger.log(LOG_ERROR, "Response: " + res.body);
         return "";
     }
-    return response;
+    return res.body;
 }
 // Once we have the authorization code, we now need to exchange the code for tokens.
 // setter method
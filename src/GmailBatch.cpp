@@ -0,0 +1,147 @@
+#include "GmailBatch.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+// Position just past the first blank line at or after pos, or npos
+size_t skipHeaders(std::string_view text, size_t pos) {
+    size_t crlf = text.find("\r\n\r\n", pos);
+    size_t lf = text.find("\n\n", pos);
+    if (crlf != std::string_view::npos && (lf == std::string_view::npos || crlf < lf)) return crlf + 4;
+    if (lf != std::string_view::npos) return lf + 2;
+    return std::string_view::npos;
+}
+
+// Case-insensitive header lookup within a header block
+std::string_view headerValue(std::string_view headers, std::string_view name) {
+    size_t lineStart = 0;
+    while (lineStart < headers.size()) {
+        size_t lineEnd = headers.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) lineEnd = headers.size();
+        std::string_view line = headers.substr(lineStart, lineEnd - lineStart);
+        if (line.size() > name.size() && line[name.size()] == ':' &&
+            equalsIgnoreCase(line.substr(0, name.size()), name)) {
+            std::string_view v = line.substr(name.size() + 1);
+            while (!v.empty() && (v.front() == ' ' || v.front() == '\t')) v.remove_prefix(1);
+            while (!v.empty() && (v.back() == '\r' || v.back() == ' ')) v.remove_suffix(1);
+            return v;
+        }
+        lineStart = lineEnd + 1;
+    }
+    return {};
+}
+
+// Next "--boundary" at the start of a line, so the same text inside a
+// message body is not taken for a delimiter
+size_t findDelimiter(std::string_view body, std::string_view delimiter, size_t from) {
+    size_t pos = body.find(delimiter, from);
+    while (pos != std::string_view::npos && pos != 0 && body[pos - 1] != '\n') {
+        pos = body.find(delimiter, pos + 1);
+    }
+    return pos;
+}
+
+// Number after the last "item" of a Content-ID, e.g. <response-item12>
+bool contentIdIndex(std::string_view contentId, size_t& index) {
+    size_t item = contentId.rfind("item");
+    if (item == std::string_view::npos) return false;
+    size_t i = item + 4;
+    if (i >= contentId.size() || !std::isdigit(static_cast<unsigned char>(contentId[i]))) return false;
+    index = 0;
+    for (; i < contentId.size() && std::isdigit(static_cast<unsigned char>(contentId[i])); ++i) {
+        index = index * 10 + static_cast<size_t>(contentId[i] - '0');
+    }
+    return true;
+}
+
+} // namespace
+
+namespace GmailBatch {
+
+const std::string BOUNDARY = "ascend_batch_7f3a9c";
+
+std::string urlPath(const std::string& url) {
+    size_t scheme = url.find("://");
+    size_t slash = url.find('/', scheme == std::string::npos ? 0 : scheme + 3);
+    return slash == std::string::npos ? "" : url.substr(slash);
+}
+
+std::string buildBody(const std::string& apiPath, const std::vector<std::string>& ids,
+                      size_t first, size_t count) {
+    std::string body;
+    body.reserve(count * (apiPath.size() + 128));
+    for (size_t i = 0; i < count; ++i) {
+        body += "--" + BOUNDARY + "\r\n";
+        body += "Content-Type: application/http\r\n";
+        body += "Content-ID: <item" + std::to_string(i) + ">\r\n\r\n";
+        body += "GET " + apiPath + "/messages/" + ids[first + i] + "?format=full\r\n\r\n";
+    }
+    body += "--" + BOUNDARY + "--\r\n";
+    return body;
+}
+
+std::string boundaryFrom(std::string_view contentType) {
+    // Parameter names are case-insensitive: "Boundary=" is as good
+    std::string lower(contentType);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    size_t pos = lower.find("boundary=");
+    if (pos == std::string::npos) return "";
+    std::string_view b = contentType.substr(pos + 9);
+    if (!b.empty() && b.front() == '"') {
+        b.remove_prefix(1);
+        b = b.substr(0, b.find('"'));
+    } else {
+        b = b.substr(0, b.find_first_of("; \t\r\n"));
+    }
+    return std::string(b);
+}
+
+bool demux(std::string_view contentType, std::string_view body, std::vector<Item>& items) {
+    const std::string boundary = boundaryFrom(contentType);
+    if (boundary.empty()) return false;
+    const std::string delimiter = "--" + boundary;
+
+    size_t pos = findDelimiter(body, delimiter, 0);
+    size_t ordinal = 0;
+    while (pos != std::string_view::npos) {
+        pos += delimiter.size();
+        if (body.compare(pos, 2, "--") == 0) return true;  // closing delimiter
+        size_t next = findDelimiter(body, delimiter, pos);
+        if (next == std::string_view::npos) return false;
+        std::string_view part = body.substr(pos, next - pos);
+
+        Item item;
+        item.index = ordinal++;
+        size_t innerStart = skipHeaders(part, 0);
+        if (innerStart != std::string_view::npos) {
+            contentIdIndex(headerValue(part.substr(0, innerStart), "Content-ID"), item.index);
+            // Embedded response: "HTTP/1.1 200 OK", headers, blank line, body
+            std::string_view inner = part.substr(innerStart);
+            size_t sp = inner.find(' ');
+            if (inner.rfind("HTTP/", 0) == 0 && sp != std::string_view::npos) {
+                item.status = std::atoi(std::string(inner.substr(sp + 1, 3)).c_str());
+            }
+            size_t bodyStart = skipHeaders(inner, 0);
+            if (bodyStart != std::string_view::npos) {
+                item.body = inner.substr(bodyStart);
+                while (!item.body.empty() && (item.body.back() == '\n' || item.body.back() == '\r')) {
+                    item.body.remove_suffix(1);
+                }
+            }
+        }
+        items.push_back(item);
+        pos = next;
+    }
+    return false;
+}
+
+}
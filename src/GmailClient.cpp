@@ -3,76 +3,78 @@
 #include <sstream>
 #include <algorithm>
 #include "GmailClient.h"
+#include "GmailBatch.h"
+#include "Base64.h"
+#include "ScratchArena.h"
 #include "logger.h"
-#include <curl/curl.h>
 #include <nlohmann/json.hpp>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <cstdlib>
+#include <string_view>
+#include <limits>
 using json = nlohmann::json;
 extern Logger logger;
 static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
-    ((std::string*)userp)->append((char*)contents, size * nmemb);
+    ((std::pmr::string*)userp)->append((char*)contents, size * nmemb);
     return size * nmemb;
 }
 // Constructor
-GmailClient::GmailClient(std::shared_ptr<GmailAuth> auth) {
+GmailClient::GmailClient(std::shared_ptr<GmailAuth> auth, std::shared_ptr<HttpSession> session, const std::string& baseUrl) {
     auth_ = auth;
-    baseUrl_ ="https://gmail.googleapis.com/gmail/v1/users/me";
+    session_ = session;
+    baseUrl_ = baseUrl;
     logger.log(LOG_INFO, "GmailClient initialized");
-    curl_global_init(CURL_GLOBAL_DEFAULT);
 }
 // Destructor
 GmailClient::~GmailClient() {
     logger.log(LOG_INFO,"GmailClient Cleaning up");
-    curl_global_cleanup();
 }
-std::string GmailClient::makeGetRequest(const std::string& endpoint) {
-    // But first check the status of token
+void GmailClient::setMaxConcurrentFetches(size_t limit) {
+    maxConcurrentFetches_ = std::max<size_t>(1, limit);
+}
+void GmailClient::setBatch(const std::string& batchUrl, size_t batchSize) {
+    batchUrl_ = batchSize > 0 ? batchUrl : "";
+    batchSize_ = std::max<size_t>(1, batchSize);
+}
+bool GmailClient::ensureToken() {
     if (auth_->isTokenExpired()) {
         logger.log(LOG_INFO, "GmailClient Token expired, refreshing...");
         if (!auth_->refreshToken()) {
             logger.log(LOG_ERROR, "Failed to refresh token!");
-            return "";
+            return false;
         }
     }
-    // Initialize Curl object
-    CURL * curl = curl_easy_init();
-    if (!curl) {
-        logger.log(LOG_ERROR, "Failed to initialize CURL");
-        return "";
+    return true;
+}
+HttpResponse GmailClient::apiGet(const std::string& endpoint) {
+    // But first check the status of token
+    if (!ensureToken()) {
+        HttpResponse failed;
+        failed.curlCode = CURLE_LOGIN_DENIED;
+        failed.error = "no valid access token";
+        return failed;
     }
-    // Store Response
-    std::string response;
     // When making get request append the endpoint to the base url to hit correct api endpoint
-    std::string url = baseUrl_ + endpoint;
-    std::string authHeader = "Authorization: Bearer " + auth_->getAccessToken();
-
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, authHeader.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    // Configure For get Request
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
-    // Store Response code
-    CURLcode res = curl_easy_perform(curl);
-    if (res != CURLE_OK) {
-        logger.log(LOG_ERROR, "[ERROR] CURL request failed: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        return "";
-    }
-    // Store Http code
-    long httpCode = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
-    if (httpCode != 200) { // 200 indicates success
-        logger.log(LOG_ERROR, "HTTP error " + std::to_string(httpCode));
-        logger.log(LOG_ERROR,"   Response: " + response);
+    // The session keeps the connection open between requests
+    HttpResponse res = session_->get(baseUrl_ + endpoint, {
+        "Authorization: Bearer " + auth_->getAccessToken(),
+        "Content-Type: application/json"
+    });
+    if (res.curlCode != CURLE_OK) {
+        logger.log(LOG_ERROR, "[ERROR] CURL request failed: " + res.error);
     }
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-    return response;
+    return res;
+}
+std::string GmailClient::makeGetRequest(const std::string& endpoint) {
+    HttpResponse res = apiGet(endpoint);
+    if (res.curlCode != CURLE_OK) return "";
+    if (res.status != 200) { // 200 indicates success
+        logger.log(LOG_ERROR, "HTTP error " + std::to_string(res.status));
+        logger.log(LOG_ERROR,"   Response: " + res.body);
+    }
+    return res.body;
 }
 
 // Called from top level of main loop
@@ -80,12 +82,8 @@ std::vector<GmailMessage> GmailClient::getMessageAfter(time_t afterTime, const s
     std::string query = "after:" + std::to_string(afterTime) + " from:" + senderEmail;
     logger.log(LOG_INFO,"GmailClient Searching for: \"" + query + "\"");
 
-    CURL* curl = curl_easy_init();
-    char* encodedQuery = curl_easy_escape(curl, query.c_str(), query.length());
     std::stringstream endpoint;
-    endpoint << "/messages?q=" << encodedQuery;
-    curl_free(encodedQuery);
-    curl_easy_cleanup(curl);
+    endpoint << "/messages?q=" << session_->escape(query);
     // Response stores message ID
     std::string response = makeGetRequest(endpoint.str());
     //logger.log(LOG_INFO,"initial Response: " + response);
@@ -96,93 +94,638 @@ std::vector<GmailMessage> GmailClient::getMessageAfter(time_t afterTime, const s
     }
     
     nlohmann::json json = nlohmann::json::parse(response);
-    std::vector<GmailMessage> messages;
+    std::vector<std::string> ids;
     // Use ID's to make api request to get body text
     if (json.contains("messages")) {
         for (const auto& msgRef : json["messages"]) {
-            std::string msgId = msgRef["id"];
-            GmailMessage fullMsg = getMessageById(msgId);
-            messages.push_back(fullMsg);
+            ids.push_back(msgRef["id"].get<std::string>());
         }
     }
-    return messages;
+    std::vector<FetchStatus> status;
+    return fetchAll(ids, status);
 }
 
-// Make API calls BY ID
-GmailMessage GmailClient::getMessageById(const std::string& messageId) {
-    std::string endpoint = "/messages/" + messageId + "?format=full";
-    std::string response = makeGetRequest(endpoint);
-    //logger.log(LOG_INFO, "Full Response By ID (" + messageId + "): "  + response);
-    if (response.empty()) {
-        logger.log(LOG_ERROR, "Empty response for message ID: " + messageId);
+std::vector<GmailMessage> GmailClient::fetchAll(const std::vector<std::string>& ids, std::vector<FetchStatus>& status) {
+    if (!batchUrl_.empty() && ids.size() > 1) return fetchMessagesBatched(ids, status);
+    return fetchMessages(ids, status);
+}
+
+// 404/410 mean the message was deleted or moved after it was listed;
+// asking again will not bring it back
+GmailClient::FetchStatus GmailClient::statusFor(const std::string& messageId, long httpCode) {
+    if (httpCode == 200) return FetchStatus::Ok;
+    if (httpCode == 404 || httpCode == 410) {
+        logger.log(LOG_WARNING, "Message " + messageId + " is gone (HTTP " + std::to_string(httpCode) + "), skipping it");
+        return FetchStatus::Gone;
     }
-    return parseResponse(response);
+    return FetchStatus::Failed;
 }
-// Parse Response and map to struct GmailMessage
-GmailMessage GmailClient::parseResponse(const std::string& jsonResponse) {
-    GmailMessage message;
+
+// ============================================================
+//   HISTORY SYNC
+// ============================================================
+//   users.history.list returns the messages added since a historyId.
+//   The last historyId seen is persisted, so each poll (and a restart)
+//   only asks for the delta. With no checkpoint, the current historyId
+//   from /profile becomes the starting point. If Gmail no longer has
+//   history that old (404), one after: search covers the gap and the
+//   checkpoint is re-seeded from /profile.
+
+void GmailClient::enableHistorySync(const std::string& checkpointPath) {
+    checkpointPath_ = checkpointPath;
+    historyId_.clear();
+    std::ifstream file(checkpointPath_);
+    if (!file.is_open()) {
+        logger.log(LOG_INFO, "No history checkpoint at " + checkpointPath_ + ", starting from current mailbox state");
+        return;
+    }
+    try {
+        json j;
+        file >> j;
+        historyId_ = j.value("historyId", "");
+        logger.log(LOG_INFO, "Resuming Gmail history sync from historyId " + historyId_);
+    } catch (const json::exception& e) {
+        logger.log(LOG_ERROR, "Failed to parse history checkpoint: " + std::string(e.what()));
+    }
+}
+
+bool GmailClient::saveCheckpoint() {
+    const std::string tmpPath = checkpointPath_ + ".tmp";
+    std::ofstream file(tmpPath, std::ios::trunc);
+    if (!file.is_open()) {
+        logger.log(LOG_ERROR, "Could not open " + tmpPath + " for writing");
+        return false;
+    }
+    file << json{{"historyId", historyId_}, {"savedAt", time(nullptr)}}.dump(2);
+    file.close();
+    if (!file || std::rename(tmpPath.c_str(), checkpointPath_.c_str()) != 0) {
+        logger.log(LOG_ERROR, "Failed to write history checkpoint " + checkpointPath_);
+        return false;
+    }
+    return true;
+}
+
+bool GmailClient::seedHistoryId() {
+    HttpResponse res = apiGet("/profile");
+    if (!res.ok()) {
+        logger.log(LOG_ERROR, "Failed to read mailbox profile (HTTP " + std::to_string(res.status) + ")");
+        return false;
+    }
     try {
-        json j = json::parse(jsonResponse);
-        message.id = j["id"].get<std::string>();
-        message.threadId = j["threadId"].get<std::string>();
-        if (j.contains("snippet")) {
-            message.snippet = j["snippet"].get<std::string>();
-        }
-        if (j.contains("payload") && j["payload"].contains("headers")) {
-            for (const auto& header : j["payload"]["headers"]) {
-                std::string name = header["name"].get<std::string>();
-                std::string value = header["value"].get<std::string>();
-                if (name == "Subject") {
-                    message.subject = value;
-                } else if (name == "From") {
-                    message.from = value;
-                } else if (name == "To") {
-                    message.to = value;
-                } else if (name == "Date") {
-                    message.date = value;
+        historyId_ = json::parse(res.body).at("historyId").get<std::string>();
+    } catch (const json::exception& e) {
+        logger.log(LOG_ERROR, "Failed to parse mailbox profile: " + std::string(e.what()));
+        return false;
+    }
+    logger.log(LOG_INFO, "Gmail history checkpoint set to " + historyId_);
+    return saveCheckpoint();
+}
+
+std::vector<GmailMessage> GmailClient::getNewMessages(time_t afterTime, const std::string& senderEmail) {
+    if (checkpointPath_.empty()) return getMessageAfter(afterTime, senderEmail);
+    if (historyId_.empty()) {
+        // Nothing to diff against yet; messages from now on come through history
+        if (!seedHistoryId()) return getMessageAfter(afterTime, senderEmail);
+        return {};
+    }
+
+    std::vector<std::string> ids;
+    std::string latestHistoryId = historyId_;
+    std::string pageToken;
+    do {
+        std::string endpoint = "/history?historyTypes=messageAdded&labelId=INBOX&startHistoryId=" + historyId_;
+        if (!pageToken.empty()) endpoint += "&pageToken=" + session_->escape(pageToken);
+        HttpResponse res = apiGet(endpoint);
+        if (res.status == 404) {
+            logger.log(LOG_WARNING, "History " + historyId_ + " expired, falling back to search");
+            std::vector<GmailMessage> messages = getMessageAfter(afterTime, senderEmail);
+            historyId_.clear();
+            seedHistoryId();
+            return messages;
+        }
+        if (!res.ok()) {
+            logger.log(LOG_ERROR, "History request failed (HTTP " + std::to_string(res.status) + ")");
+            if (res.curlCode == CURLE_OK) logger.log(LOG_ERROR, "   Response: " + res.body);
+            return {};
+        }
+        try {
+            json j = json::parse(res.body);
+            if (j.contains("history")) {
+                for (const auto& record : j["history"]) {
+                    if (!record.contains("messagesAdded")) continue;
+                    for (const auto& added : record["messagesAdded"]) {
+                        ids.push_back(added["message"]["id"].get<std::string>());
+                    }
                 }
             }
+            latestHistoryId = j.value("historyId", latestHistoryId);
+            pageToken = j.value("nextPageToken", "");
+        } catch (const json::exception& e) {
+            logger.log(LOG_ERROR, "Failed to parse history response: " + std::string(e.what()));
+            return {};
+        }
+    } while (!pageToken.empty());
+
+    // A message can show up in more than one history record
+    std::vector<std::string> unique;
+    for (auto& id : ids) {
+        if (std::find(unique.begin(), unique.end(), id) == unique.end()) unique.push_back(std::move(id));
+    }
+
+    std::vector<FetchStatus> status;
+    std::vector<GmailMessage> messages = fetchAll(unique, status);
+
+    // IDs that failed this time keep the checkpoint, up to MAX_FETCH_ATTEMPTS polls each
+    size_t pending = 0;
+    for (size_t i = 0; i < unique.size(); ++i) {
+        if (status[i] != FetchStatus::Failed) {
+            fetchAttempts_.erase(unique[i]);
+            continue;
         }
-        if (j.contains("payload")) {
-            std::string plainText = extractBodyFromParts(j["payload"].dump(), "text/plain");
-            std::string htmlText = extractBodyFromParts(j["payload"].dump(), "text/html");
-            message.bodyText = plainText;
-            message.bodyHtml = htmlText;
+        int attempts = ++fetchAttempts_[unique[i]];
+        if (attempts >= MAX_FETCH_ATTEMPTS) {
+            logger.log(LOG_ERROR, "Giving up on message " + unique[i] + " after " + std::to_string(attempts) + " failed fetches");
+            fetchAttempts_.erase(unique[i]);
+            continue;
         }
-        logger.log(LOG_INFO, "GmailClient Parsed message from: " + message.from);
-    } catch (const json::exception& e) {
-        logger.log(LOG_ERROR, "Failed to parse message: " + std::string(e.what()));
+        ++pending;
     }
-    return message;
+    if (!senderEmail.empty()) {
+        messages.erase(std::remove_if(messages.begin(), messages.end(), [&](const GmailMessage& m) {
+            return m.from.find(senderEmail) == std::string::npos;
+        }), messages.end());
+    }
+    logger.log(LOG_INFO, "GmailClient History " + historyId_ + " -> " + latestHistoryId + ": " +
+        std::to_string(unique.size()) + " added, " + std::to_string(messages.size()) + " from modem");
+
+    // Only move past this delta once every message in it was fetched, is
+    // gone, or was given up on; otherwise the next poll asks again (frames
+    // already stored are skipped)
+    if (pending > 0) {
+        logger.log(LOG_WARNING, std::to_string(pending) + "/" + std::to_string(unique.size()) +
+            " new message(s) failed to fetch, keeping history checkpoint " + historyId_ + " to retry them");
+    } else if (latestHistoryId != historyId_) {
+        historyId_ = latestHistoryId;
+        fetchAttempts_.clear();
+        saveCheckpoint();
+    }
+    return messages;
 }
-// Sample Base 64 encoded email content
-std::string GmailClient::extractBodyFromParts(const std::string& partsJson, const std::string& mimeType) {
-    try {
-        json payload = json::parse(partsJson);
-        if (payload.contains("mimeType") && 
-            payload["mimeType"].get<std::string>() == mimeType &&
-            payload.contains("body") && 
-            payload["body"].contains("data")) {
-            return decodeBase64Url(payload["body"]["data"].get<std::string>());
-        }
-        if (payload.contains("parts")) {
-            for (const auto& part : payload["parts"]) {
-                if (part.contains("mimeType") && 
-                    part["mimeType"].get<std::string>() == mimeType &&
-                    part.contains("body") && 
-                    part["body"].contains("data")) {
-                    return decodeBase64Url(part["body"]["data"].get<std::string>());
+
+// Fetches the IDs batchSize_ at a time through the batch endpoint. IDs the
+// batch could not deliver (envelope error, per-item error other than gone,
+// unparseable body) are retried with the concurrent per-message fetch.
+std::vector<GmailMessage> GmailClient::fetchMessagesBatched(const std::vector<std::string>& ids,
+                                                            std::vector<FetchStatus>& status) {
+    status.assign(ids.size(), FetchStatus::Failed);
+    if (!ensureToken()) return {};
+    std::pmr::memory_resource* scratch = ScratchArena::forThread().resource();
+    const std::string apiPath = GmailBatch::urlPath(baseUrl_);
+    const std::string authHeader = "Authorization: Bearer " + auth_->getAccessToken();
+
+    std::vector<GmailMessage> messages;
+    std::vector<std::string> retry;
+    std::vector<size_t> retryIndex;  // position of retry[i] in ids
+    messages.reserve(ids.size());
+    size_t requests = 0;
+
+    for (size_t first = 0; first < ids.size(); first += batchSize_) {
+        const size_t count = std::min(batchSize_, ids.size() - first);
+        HttpResponse res = session_->post(batchUrl_, GmailBatch::buildBody(apiPath, ids, first, count), {
+            authHeader,
+            "Content-Type: multipart/mixed; boundary=" + GmailBatch::BOUNDARY
+        });
+        ++requests;
+
+        std::vector<GmailBatch::Item> items;
+        if (!res.ok() || !GmailBatch::demux(res.contentType, res.body, items)) {
+            logger.log(LOG_WARNING, "Batch request failed (" + (res.curlCode != CURLE_OK ? res.error :
+                "HTTP " + std::to_string(res.status)) + "), falling back to per-message fetch");
+            for (size_t i = first; i < first + count; ++i) {
+                retry.push_back(ids[i]);
+                retryIndex.push_back(i);
+            }
+            continue;
+        }
+
+        std::vector<bool> answered(count, false);
+        for (const GmailBatch::Item& item : items) {
+            if (item.index >= count || answered[item.index]) continue;
+            const size_t i = first + item.index;
+            FetchStatus s = statusFor(ids[i], item.status);
+            if (s == FetchStatus::Failed) {
+                logger.log(LOG_WARNING, "Batch item " + ids[i] + " returned HTTP " + std::to_string(item.status));
+                continue;
+            }
+            if (s == FetchStatus::Ok) {
+                GmailMessage msg = parseResponse(item.body, scratch);
+                if (msg.id.empty()) {
+                    logger.log(LOG_WARNING, "Batch item " + ids[i] + " could not be parsed");
+                    continue;
                 }
-                if (part.contains("parts")) {
-                    std::string result = extractBodyFromParts(part.dump(), mimeType);
-                    if (!result.empty()) return result;
+                messages.push_back(std::move(msg));
+            }
+            answered[item.index] = true;
+            status[i] = s;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (!answered[i]) {
+                retry.push_back(ids[first + i]);
+                retryIndex.push_back(first + i);
+            }
+        }
+    }
+
+    logger.log(LOG_INFO, "GmailClient Fetched " + std::to_string(messages.size()) + "/" +
+        std::to_string(ids.size()) + " message(s) in " + std::to_string(requests) + " batch request(s)");
+    if (!retry.empty()) {
+        std::vector<FetchStatus> retryStatus;
+        std::vector<GmailMessage> rest = fetchMessages(retry, retryStatus);
+        for (size_t i = 0; i < retry.size(); ++i) status[retryIndex[i]] = retryStatus[i];
+        messages.insert(messages.end(), std::make_move_iterator(rest.begin()), std::make_move_iterator(rest.end()));
+    }
+    sortByMomsn(messages);
+    return messages;
+}
+
+// Fetches every ID with at most maxConcurrentFetches_ requests in flight on a
+// curl multi handle (multiplexed over one HTTP/2 connection when available),
+// then orders the results by MOMSN. Failed fetches are logged and skipped.
+std::vector<GmailMessage> GmailClient::fetchMessages(const std::vector<std::string>& ids,
+                                                     std::vector<FetchStatus>& status) {
+    status.assign(ids.size(), FetchStatus::Failed);
+    if (ids.empty()) return {};
+    if (ids.size() == 1) {
+        std::vector<GmailMessage> one;
+        GmailMessage msg = getMessageById(ids[0], status[0]);
+        if (status[0] == FetchStatus::Ok) one.push_back(std::move(msg));
+        return one;
+    }
+    if (!ensureToken()) return {};
+
+    // Response bodies and their parse live in the thread's scratch arena
+    std::pmr::memory_resource* scratch = ScratchArena::forThread().resource();
+    struct Transfer {
+        explicit Transfer(std::pmr::memory_resource* resource) : body(resource) {}
+        CURL* handle = nullptr;
+        size_t index = 0;
+        bool active = false;    // attached to the multi handle
+        std::pmr::string body;
+    };
+
+    CURLM* multi = curl_multi_init();
+    if (!multi) {
+        logger.log(LOG_ERROR, "Failed to initialize CURL multi handle");
+        return {};
+    }
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+    const std::string authHeader = "Authorization: Bearer " + auth_->getAccessToken();
+    struct curl_slist* headers = nullptr;
+    headers = curl_slist_append(headers, authHeader.c_str());
+    headers = curl_slist_append(headers, "Content-Type: application/json");
+
+    const size_t slots = std::min(maxConcurrentFetches_, ids.size());
+    std::vector<Transfer> transfers;
+    transfers.reserve(slots);
+    for (size_t i = 0; i < slots; ++i) transfers.emplace_back(scratch);  // a copy would leave the arena
+    std::vector<std::string> urls(ids.size());
+    std::pmr::vector<std::pmr::string> responses(ids.size(), scratch);
+    std::vector<bool> fetched(ids.size(), false);
+    size_t next = 0;
+    size_t active = 0;
+
+    auto start = [&](Transfer& t) {
+        t.index = next++;
+        t.body.clear();
+        urls[t.index] = baseUrl_ + "/messages/" + ids[t.index] + "?format=full";
+        curl_easy_reset(t.handle);
+        session_->configure(t.handle);
+        curl_easy_setopt(t.handle, CURLOPT_URL, urls[t.index].c_str());
+        curl_easy_setopt(t.handle, CURLOPT_HTTPHEADER, headers);
+        curl_easy_setopt(t.handle, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(t.handle, CURLOPT_WRITEDATA, &t.body);
+        curl_easy_setopt(t.handle, CURLOPT_PRIVATE, &t);
+        curl_multi_add_handle(multi, t.handle);
+        t.active = true;
+        ++active;
+    };
+
+    for (auto& t : transfers) {
+        t.handle = session_->newHandle();
+        if (t.handle && next < ids.size()) start(t);
+    }
+    if (active == 0) {
+        logger.log(LOG_ERROR, "Failed to create any CURL handle for " + std::to_string(ids.size()) + " message fetch(es)");
+    }
+
+    // Until every started transfer has finished; finished slots pick up the next ID
+    while (active > 0) {
+        int running = 0;
+        CURLMcode mc = curl_multi_perform(multi, &running);
+        if (mc == CURLM_OK && running > 0) mc = curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        if (mc != CURLM_OK) {
+            logger.log(LOG_ERROR, "CURL multi failed: " + std::string(curl_multi_strerror(mc)));
+            break;
+        }
+
+        int queued = 0;
+        while (CURLMsg* m = curl_multi_info_read(multi, &queued)) {
+            if (m->msg != CURLMSG_DONE) continue;
+            Transfer* t = nullptr;
+            curl_easy_getinfo(m->easy_handle, CURLINFO_PRIVATE, &t);
+            long httpCode = 0;
+            curl_easy_getinfo(m->easy_handle, CURLINFO_RESPONSE_CODE, &httpCode);
+            if (m->data.result != CURLE_OK) {
+                logger.log(LOG_ERROR, "[ERROR] CURL request failed for message " + ids[t->index] + ": " +
+                    std::string(curl_easy_strerror(m->data.result)));
+            } else if ((status[t->index] = statusFor(ids[t->index], httpCode)) == FetchStatus::Failed) {
+                logger.log(LOG_ERROR, "HTTP error " + std::to_string(httpCode) + " for message " + ids[t->index]);
+                ASCEND_LOG(LOG_ERROR, "   Response: {}", t->body);
+            } else if (httpCode == 200) {
+                responses[t->index] = std::move(t->body);
+                fetched[t->index] = true;
+            }
+            curl_multi_remove_handle(multi, t->handle);
+            t->active = false;
+            --active;
+            if (next < ids.size()) start(*t);
+        }
+    }
+
+    // After a multi error some transfers are still attached; detach before cleanup
+    for (auto& t : transfers) {
+        if (t.active) curl_multi_remove_handle(multi, t.handle);
+        if (t.handle) curl_easy_cleanup(t.handle);
+    }
+    curl_multi_cleanup(multi);
+    curl_slist_free_all(headers);
+
+    std::vector<GmailMessage> messages;
+    messages.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if (!fetched[i]) continue;
+        GmailMessage msg = parseResponse(responses[i], scratch);
+        if (msg.id.empty()) {
+            logger.log(LOG_ERROR, "Could not parse message " + ids[i]);
+            status[i] = FetchStatus::Failed;
+            continue;
+        }
+        messages.push_back(std::move(msg));
+    }
+    sortByMomsn(messages);
+    logger.log(LOG_INFO, "GmailClient Fetched " + std::to_string(messages.size()) + "/" +
+        std::to_string(ids.size()) + " message(s), up to " + std::to_string(slots) + " in flight");
+    return messages;
+}
+
+// Search results come newest first; decode in transmit order
+void GmailClient::sortByMomsn(std::vector<GmailMessage>& messages) {
+    std::stable_sort(messages.begin(), messages.end(), [](const GmailMessage& a, const GmailMessage& b) {
+        return momsnFromSubject(a.subject) < momsnFromSubject(b.subject);
+    });
+}
+
+// "Message 55 from RockBLOCK 300534065390120" (possibly with a Fwd: prefix) -> 55.
+// Subjects without a MOMSN sort last.
+int GmailClient::momsnFromSubject(std::string_view subject) {
+    constexpr std::string_view marker = "Message ";
+    size_t pos = subject.find(marker);
+    while (pos != std::string_view::npos) {
+        size_t i = pos + marker.size();
+        int momsn = 0;
+        size_t digits = 0;
+        while (i < subject.size() && std::isdigit(static_cast<unsigned char>(subject[i])) && digits < 9) {
+            momsn = momsn * 10 + (subject[i] - '0');
+            ++i;
+            ++digits;
+        }
+        if (digits > 0 && subject.compare(i, 15, " from RockBLOCK") == 0) return momsn;
+        pos = subject.find(marker, pos + 1);
+    }
+    return std::numeric_limits<int>::max();
+}
+
+// Make API calls BY ID
+GmailMessage GmailClient::getMessageById(const std::string& messageId, FetchStatus& status) {
+    std::string endpoint = "/messages/" + messageId + "?format=full";
+    HttpResponse res = apiGet(endpoint);
+    status = res.curlCode == CURLE_OK ? statusFor(messageId, res.status) : FetchStatus::Failed;
+    if (status != FetchStatus::Ok) {
+        if (status == FetchStatus::Failed && res.curlCode == CURLE_OK) {
+            logger.log(LOG_ERROR, "HTTP error " + std::to_string(res.status) + " for message " + messageId);
+            logger.log(LOG_ERROR, "   Response: " + res.body);
+        }
+        return {};
+    }
+    GmailMessage msg = parseResponse(res.body, ScratchArena::forThread().resource());
+    if (msg.id.empty()) {
+        logger.log(LOG_ERROR, "Could not parse message " + messageId);
+        status = FetchStatus::Failed;
+    }
+    return msg;
+}
+// ============================================================
+//   STREAMING MESSAGE PARSER
+// ============================================================
+//   SAX handler over the messages.get response. Tracks where it is in
+//   the document with a small context stack and keeps only what
+//   GmailMessage needs: id, threadId, snippet, the top-level payload
+//   headers and the body.data of the first text/plain and text/html
+//   part in pre-order (the payload itself, then parts depth-first).
+//   Body data is base64url-decoded once, after parsing.
+//
+//   Everything the handler keeps is in the caller's memory resource.
+//   Token text is copied out of the lexer's buffer, not moved, so that
+//   buffer keeps its capacity for the next token.
+namespace {
+
+class MessageSaxHandler : public json::json_sax_t {
+public:
+    MessageSaxHandler(GmailMessage& message, std::pmr::memory_resource* resource)
+        : message_(message), resource_(resource), stack_(resource), key_(resource),
+          headerName_(resource), headerValue_(resource), plain_(resource), html_(resource) {
+        stack_.reserve(16);
+    }
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t) override { return true; }
+    bool number_unsigned(number_unsigned_t) override { return true; }
+    bool number_float(number_float_t, const string_t&) override { return true; }
+    bool binary(binary_t&) override { return true; }
+
+    bool string(string_t& val) override {
+        if (stack_.empty()) return true;
+        Frame& f = stack_.back();
+        switch (f.ctx) {
+            case Ctx::Root:
+                if (key_ == "id") message_.id.assign(val);
+                else if (key_ == "threadId") message_.threadId.assign(val);
+                else if (key_ == "snippet") message_.snippet.assign(val);
+                break;
+            case Ctx::Part:
+                if (key_ == "mimeType") {
+                    if (val == "text/plain") f.mime = Mime::Plain;
+                    else if (val == "text/html") f.mime = Mime::Html;
                 }
+                break;
+            case Ctx::Body:
+                if (key_ == "data") {
+                    Frame& part = stack_[stack_.size() - 2];
+                    part.data.assign(val);
+                    part.hasData = true;
+                }
+                break;
+            case Ctx::Header:
+                if (key_ == "name") headerName_.assign(val);
+                else if (key_ == "value") headerValue_.assign(val);
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    bool key(string_t& val) override {
+        key_.assign(val);
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        Frame f(resource_);
+        if (stack_.empty()) {
+            f.ctx = Ctx::Root;
+        } else {
+            const Frame& parent = stack_.back();
+            if (parent.ctx == Ctx::Root && key_ == "payload") {
+                f.ctx = Ctx::Part;
+                f.top = true;
+            } else if (parent.ctx == Ctx::Parts) {
+                f.ctx = Ctx::Part;
+            } else if (parent.ctx == Ctx::Part && key_ == "body") {
+                f.ctx = Ctx::Body;
+            } else if (parent.ctx == Ctx::Headers) {
+                f.ctx = Ctx::Header;
+                headerName_.clear();
+                headerValue_.clear();
             }
         }
-    } catch (const json::exception& e) {
-        logger.log(LOG_ERROR,"extracting body: " + std::string(e.what()));
+        if (f.ctx == Ctx::Part) f.order = nextPartOrder_++;
+        stack_.push_back(std::move(f));
+        return true;
+    }
+
+    bool end_object() override {
+        Frame& f = stack_.back();
+        if (f.ctx == Ctx::Header) {
+            applyHeader();
+        } else if (f.ctx == Ctx::Part && f.hasData) {
+            if (f.mime == Mime::Plain) offer(plain_, f);
+            else if (f.mime == Mime::Html) offer(html_, f);
+        }
+        stack_.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        Frame f(resource_);
+        if (!stack_.empty() && stack_.back().ctx == Ctx::Part) {
+            if (key_ == "parts") f.ctx = Ctx::Parts;
+            else if (key_ == "headers" && stack_.back().top) f.ctx = Ctx::Headers;
+        }
+        stack_.push_back(std::move(f));
+        return true;
+    }
+
+    bool end_array() override {
+        stack_.pop_back();
+        return true;
     }
-    return "";
+
+    bool parse_error(std::size_t, const std::string&, const json::exception& ex) override {
+        error_ = ex.what();
+        return false;
+    }
+
+    const std::string& error() const { return error_; }
+    std::pmr::string* plainData() { return plain_.found ? &plain_.data : nullptr; }
+    std::pmr::string* htmlData() { return html_.found ? &html_.data : nullptr; }
+
+private:
+    enum class Ctx { Skip, Root, Part, Body, Parts, Headers, Header };
+    enum class Mime { Other, Plain, Html };
+
+    struct Frame {
+        explicit Frame(std::pmr::memory_resource* resource) : data(resource) {}
+        Ctx ctx = Ctx::Skip;
+        bool top = false;       // the message payload itself
+        int order = 0;          // pre-order index among parts
+        bool hasData = false;
+        Mime mime = Mime::Other;
+        std::pmr::string data;
+    };
+
+    // Parts finish in post-order, so keep the one that comes first in pre-order
+    struct Best {
+        explicit Best(std::pmr::memory_resource* resource) : data(resource) {}
+        bool found = false;
+        int order = 0;
+        std::pmr::string data;
+    };
+
+    static void offer(Best& best, Frame& f) {
+        if (best.found && best.order < f.order) return;
+        best.found = true;
+        best.order = f.order;
+        best.data = std::move(f.data);
+    }
+
+    void applyHeader() {
+        if (headerName_ == "Subject") message_.subject = std::move(headerValue_);
+        else if (headerName_ == "From") message_.from = std::move(headerValue_);
+        else if (headerName_ == "To") message_.to = std::move(headerValue_);
+        else if (headerName_ == "Date") message_.date = std::move(headerValue_);
+    }
+
+    GmailMessage& message_;
+    std::pmr::memory_resource* resource_;
+    std::pmr::vector<Frame> stack_;
+    std::pmr::string key_;
+    std::pmr::string headerName_;
+    std::pmr::string headerValue_;
+    int nextPartOrder_ = 0;
+    Best plain_;
+    Best html_;
+    std::string error_;
+};
+
+// body.data is decoded over its own buffer, no second string
+template <typename String>
+String decodeBody(String data) {
+    const Base64::Result r = Base64::decodeInPlace(data);
+    if (!r.ok()) {
+        logger.log(LOG_WARNING, "Malformed base64url message body (" + std::string(Base64::statusString(r.status)) +
+                                " at char " + std::to_string(r.errorPos) + "), keeping " +
+                                std::to_string(r.bytesWritten) + " decoded bytes");
+    }
+    return data;
+}
+
+} // namespace
+
+// Parse Response and map to struct GmailMessage
+GmailMessage GmailClient::parseResponse(std::string_view jsonResponse, std::pmr::memory_resource* resource) {
+    GmailMessage message(resource);
+    MessageSaxHandler handler(message, resource);
+    if (!json::sax_parse(jsonResponse, &handler)) {
+        logger.log(LOG_ERROR, "Failed to parse message: " + handler.error());
+        return GmailMessage(resource);
+    }
+    if (std::pmr::string* data = handler.plainData()) message.bodyText = decodeBody(std::move(*data));
+    if (std::pmr::string* data = handler.htmlData()) message.bodyHtml = decodeBody(std::move(*data));
+    ASCEND_LOG(LOG_INFO, "GmailClient Parsed message from: {}", message.from);
+    return message;
 }
 // Sample Base 64 encoded email content
 /* 
@@ -217,28 +760,5 @@ Iridium Session Status: 0
 Data: 524200333f5133207202f2e006f1633010000022700000000000000000000000000000000000000000000000000000
 */
 std::string GmailClient::decodeBase64Url(const std::string& encoded) {
-    std::string base64 = encoded;
-    replace(base64.begin(), base64.end(), '-', '+');
-    replace(base64.begin(), base64.end(), '_', '/');
-    while (base64.length() % 4 != 0) {
-        base64 += '=';
-    }
-    static const std::string base64_chars = 
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-        "abcdefghijklmnopqrstuvwxyz"
-        "0123456789+/";
-    std::string decoded;
-    std::vector<int> T(256, -1);
-    for (int i = 0; i < 64; i++) T[base64_chars[i]] = i;
-    int val = 0, valb = -8;
-    for (unsigned char c : base64) {
-        if (T[c] == -1) break;
-        val = (val << 6) + T[c];
-        valb += 6;
-        if (valb >= 0) {
-            decoded.push_back(char((val >> valb) & 0xFF));
-            valb -= 8;
-        }
-    }
-    return decoded;
+    return decodeBody(encoded);
 }
@@ -0,0 +1,183 @@
+#include "HexCodec.h"
+#include <algorithm>
+#include <array>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HEXCODEC_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr uint8_t NIBBLE_SPACE   = 0x10;
+constexpr uint8_t NIBBLE_INVALID = 0xFF;
+
+constexpr std::array<uint8_t, 256> makeNibbleTable() {
+    std::array<uint8_t, 256> t{};
+    for (auto& v : t) v = NIBBLE_INVALID;
+    for (int c = '0'; c <= '9'; ++c) t[c] = static_cast<uint8_t>(c - '0');
+    for (int c = 'a'; c <= 'f'; ++c) t[c] = static_cast<uint8_t>(c - 'a' + 10);
+    for (int c = 'A'; c <= 'F'; ++c) t[c] = static_cast<uint8_t>(c - 'A' + 10);
+    t[' '] = t['\t'] = t['\r'] = t['\n'] = t['\v'] = t['\f'] = NIBBLE_SPACE;
+    return t;
+}
+
+constexpr std::array<uint8_t, 256> NIBBLE = makeNibbleTable();
+
+#ifdef HEXCODEC_X86
+
+// 32 hex chars -> 16 bytes. Returns false (and writes nothing) if any of the
+// 32 chars is not a hex digit, so the scalar path can handle/report it.
+//
+// Per char: d = c - '0' is a digit if d <= 9, l = (c | 0x20) - 'a' is a
+// letter if l <= 5. Pairs are then merged inside each 16-bit lane as
+// (first << 4) | second and narrowed with packus.
+inline __m128i nibblesSse2(__m128i c, __m128i& bad) {
+    const __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i l = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    const __m128i isAlpha = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+    bad = _mm_or_si128(bad, _mm_andnot_si128(_mm_or_si128(isDigit, isAlpha), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(isDigit, d),
+                        _mm_and_si128(isAlpha, _mm_add_epi8(l, _mm_set1_epi8(10))));
+}
+
+inline __m128i pairNibblesSse2(__m128i v) {
+    const __m128i hi = _mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x00FF)), 4);
+    const __m128i lo = _mm_srli_epi16(v, 8);
+    return _mm_or_si128(hi, lo);
+}
+
+bool decodeBlockSse2(const char* src, uint8_t* dst) {
+    __m128i bad = _mm_setzero_si128();
+    const __m128i a = nibblesSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), bad);
+    const __m128i b = nibblesSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)), bad);
+    if (_mm_movemask_epi8(bad) != 0) return false;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(pairNibblesSse2(a), pairNibblesSse2(b)));
+    return true;
+}
+
+// Same scheme, 64 hex chars -> 32 bytes. packus works per 128-bit lane, so
+// the result is put back in order with a 64-bit permute.
+__attribute__((target("avx2")))
+inline __m256i pairedNibblesAvx2(__m256i c, __m256i& bad) {
+    const __m256i d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    const __m256i l = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+    const __m256i isAlpha = _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+    bad = _mm256_or_si256(bad, _mm256_andnot_si256(_mm256_or_si256(isDigit, isAlpha), _mm256_set1_epi8(-1)));
+    const __m256i v = _mm256_or_si256(_mm256_and_si256(isDigit, d),
+                                      _mm256_and_si256(isAlpha, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+    const __m256i hi = _mm256_slli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x00FF)), 4);
+    return _mm256_or_si256(hi, _mm256_srli_epi16(v, 8));
+}
+
+__attribute__((target("avx2")))
+bool decodeBlockAvx2(const char* src, uint8_t* dst) {
+    __m256i bad = _mm256_setzero_si256();
+    const __m256i a = pairedNibblesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)), bad);
+    const __m256i b = pairedNibblesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32)), bad);
+    if (_mm256_movemask_epi8(bad) != 0) return false;
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), packed);
+    return true;
+}
+
+bool cpuHasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+
+#endif
+
+} // namespace
+
+namespace HexCodec {
+
+Simd bestSimd() {
+#ifdef HEXCODEC_X86
+    return cpuHasAvx2() ? Simd::Avx2 : Simd::Sse2;  // SSE2 is baseline x86-64
+#else
+    return Simd::None;
+#endif
+}
+
+Result decode(std::string_view hex, std::span<uint8_t> out) {
+    return decode(hex, out, bestSimd());
+}
+
+Result decode(std::string_view hex, std::span<uint8_t> out, Simd simd) {
+    Result r;
+    const char* src = hex.data();
+    const size_t n = hex.size();
+    uint8_t* dst = out.data();
+    const size_t cap = out.size();
+    size_t i = 0;
+    size_t o = 0;
+
+#ifdef HEXCODEC_X86
+    simd = std::min(simd, bestSimd());
+    const bool avx2 = simd >= Simd::Avx2;
+    const bool sse2 = simd >= Simd::Sse2;
+#else
+    (void)simd;
+#endif
+
+    while (i < n) {
+#ifdef HEXCODEC_X86
+        if (avx2 && n - i >= 64 && cap - o >= 32 && decodeBlockAvx2(src + i, dst + o)) {
+            i += 64;
+            o += 32;
+            continue;
+        }
+        if (sse2 && n - i >= 32 && cap - o >= 16 && decodeBlockSse2(src + i, dst + o)) {
+            i += 32;
+            o += 16;
+            continue;
+        }
+#endif
+        // Scalar: one output byte, skipping whitespace around the digits
+        uint8_t hi = NIBBLE[static_cast<uint8_t>(src[i])];
+        if (hi == NIBBLE_SPACE) { ++i; continue; }
+        if (hi == NIBBLE_INVALID) {
+            r.status = Status::InvalidChar;
+            r.errorPos = i;
+            break;
+        }
+        if (o == cap) {
+            r.status = Status::Overflow;
+            r.errorPos = i;
+            break;
+        }
+        const size_t hiPos = i++;
+        while (i < n && NIBBLE[static_cast<uint8_t>(src[i])] == NIBBLE_SPACE) ++i;
+        if (i == n) {
+            r.status = Status::OddDigits;
+            r.errorPos = hiPos;
+            break;
+        }
+        uint8_t lo = NIBBLE[static_cast<uint8_t>(src[i])];
+        if (lo == NIBBLE_INVALID) {
+            r.status = Status::InvalidChar;
+            r.errorPos = i;
+            break;
+        }
+        dst[o++] = static_cast<uint8_t>((hi << 4) | lo);
+        ++i;
+    }
+
+    r.bytesWritten = o;
+    return r;
+}
+
+const char* statusString(Status status) {
+    switch (status) {
+        case Status::Ok:          return "OK";
+        case Status::InvalidChar: return "invalid character";
+        case Status::OddDigits:   return "odd number of hex digits";
+        case Status::Overflow:    return "more data than buffer";
+        default:                  return "unknown";
+    }
+}
+
+}
@@ -0,0 +1,347 @@
+#include "HttpServer.h"
+#include "logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+extern Logger logger;
+
+namespace {
+
+constexpr int READ_TIMEOUT_SECONDS = 5;   // idle keep-alive connections are closed after this
+constexpr size_t MAX_HEADER_BYTES = 16 * 1024;
+constexpr int MAX_CONNECTIONS = 64;
+
+const char* reasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 411: return "Length Required";
+        case 413: return "Payload Too Large";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default:  return "Unknown";
+    }
+}
+
+bool sendAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+std::string lower(std::string_view s) {
+    std::string out(s);
+    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return std::tolower(c); });
+    return out;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+// Parses the request line and headers in head (up to, not including, the blank line)
+bool parseHead(std::string_view head, HttpRequest& req) {
+    size_t lineEnd = head.find("\r\n");
+    std::string_view requestLine = head.substr(0, lineEnd);
+    size_t sp1 = requestLine.find(' ');
+    size_t sp2 = requestLine.rfind(' ');
+    if (sp1 == std::string_view::npos || sp2 == sp1) return false;
+    req.method = std::string(requestLine.substr(0, sp1));
+    std::string_view target = requestLine.substr(sp1 + 1, sp2 - sp1 - 1);
+    size_t q = target.find('?');
+    req.path = std::string(target.substr(0, q));
+    if (q != std::string_view::npos) req.query = std::string(target.substr(q + 1));
+
+    while (lineEnd != std::string_view::npos) {
+        size_t start = lineEnd + 2;
+        lineEnd = head.find("\r\n", start);
+        std::string_view line = head.substr(start, lineEnd == std::string_view::npos ? std::string_view::npos : lineEnd - start);
+        if (line.empty()) continue;
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos) return false;
+        req.headers.emplace_back(lower(trim(line.substr(0, colon))), std::string(trim(line.substr(colon + 1))));
+    }
+    return true;
+}
+
+} // namespace
+
+// ============================================================
+//   REQUEST HELPERS
+// ============================================================
+
+std::string_view HttpRequest::header(std::string_view name) const {
+    for (const auto& h : headers) {
+        if (h.first == name) return h.second;
+    }
+    return {};
+}
+
+std::string HttpRequest::queryParam(std::string_view name) const {
+    std::string_view q = query;
+    while (!q.empty()) {
+        size_t amp = q.find('&');
+        std::string_view pair = q.substr(0, amp);
+        size_t eq = pair.find('=');
+        if (HttpServer::urlDecode(pair.substr(0, eq)) == name) {
+            return eq == std::string_view::npos ? "" : HttpServer::urlDecode(pair.substr(eq + 1));
+        }
+        if (amp == std::string_view::npos) break;
+        q.remove_prefix(amp + 1);
+    }
+    return "";
+}
+
+std::string HttpServer::urlDecode(std::string_view value) {
+    std::string out;
+    out.reserve(value.size());
+    for (size_t i = 0; i < value.size(); ++i) {
+        char c = value[i];
+        if (c == '+') {
+            out += ' ';
+        } else if (c == '%' && i + 2 < value.size() &&
+                   std::isxdigit(static_cast<unsigned char>(value[i + 1])) &&
+                   std::isxdigit(static_cast<unsigned char>(value[i + 2]))) {
+            out += static_cast<char>(std::stoi(std::string(value.substr(i + 1, 2)), nullptr, 16));
+            i += 2;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+// ============================================================
+//   EVENT STREAM
+// ============================================================
+
+bool HttpStream::send(std::string_view data) {
+    if (failed_) return false;
+    failed_ = !sendAll(fd_, data.data(), data.size());
+    return !failed_;
+}
+
+bool HttpStream::active() const {
+    return !failed_ && running_.load();
+}
+
+// ============================================================
+//   SERVER
+// ============================================================
+
+HttpServer::~HttpServer() {
+    stop();
+}
+
+void HttpServer::route(const std::string& method, const std::string& path, Handler handler) {
+    routes_.push_back({method, path, std::move(handler), nullptr});
+}
+
+void HttpServer::routeStream(const std::string& path, StreamHandler handler) {
+    routes_.push_back({"GET", path, nullptr, std::move(handler)});
+}
+
+void HttpServer::setFallback(Handler handler) {
+    fallback_ = std::move(handler);
+}
+
+bool HttpServer::start(const std::string& bindAddress, uint16_t port) {
+    listenFd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        logger.log(LOG_ERROR, "HttpServer socket() failed: " + std::string(std::strerror(errno)));
+        return false;
+    }
+    int one = 1;
+    ::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (::inet_pton(AF_INET, bindAddress.c_str(), &addr.sin_addr) != 1) {
+        logger.log(LOG_ERROR, "HttpServer invalid bind address: " + bindAddress);
+        ::close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+    if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(listenFd_, 64) < 0) {
+        logger.log(LOG_ERROR, "HttpServer cannot listen on " + bindAddress + ":" + std::to_string(port) +
+            ": " + std::strerror(errno));
+        ::close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+
+    socklen_t len = sizeof(addr);
+    ::getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+    running_ = true;
+    acceptThread_ = std::thread(&HttpServer::acceptLoop, this);
+    logger.log(LOG_INFO, "HttpServer listening on " + bindAddress + ":" + std::to_string(port_));
+    return true;
+}
+
+void HttpServer::stop() {
+    if (!running_.exchange(false)) return;
+    ::shutdown(listenFd_, SHUT_RDWR);
+    ::close(listenFd_);
+    listenFd_ = -1;
+    if (acceptThread_.joinable()) acceptThread_.join();
+    // Connection threads notice running_ at their next read timeout
+    while (openConnections_ > 0) std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+
+void HttpServer::acceptLoop() {
+    while (running_) {
+        int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (running_) logger.log(LOG_ERROR, "HttpServer accept() failed: " + std::string(std::strerror(errno)));
+            break;
+        }
+        if (openConnections_ >= MAX_CONNECTIONS) {
+            static const char busy[] = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+            sendAll(fd, busy, sizeof(busy) - 1);
+            ::close(fd);
+            continue;
+        }
+        timeval tv{READ_TIMEOUT_SECONDS, 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        ++openConnections_;
+        std::thread([this, fd] {
+            serveConnection(fd);
+            ::close(fd);
+            --openConnections_;
+        }).detach();
+    }
+}
+
+void HttpServer::serveConnection(int fd) {
+    std::string buffer;
+    char chunk[8192];
+
+    while (running_) {
+        // Read until the end of the header block
+        size_t headEnd;
+        while ((headEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            if (buffer.size() > MAX_HEADER_BYTES) return;
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return;   // closed, error or idle timeout
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+
+        HttpRequest req;
+        HttpReply reply;
+        bool keepAlive = false;
+        if (!parseHead(std::string_view(buffer).substr(0, headEnd), req)) {
+            reply.status = 400;
+            buffer.clear();
+        } else {
+            const size_t bodyStart = headEnd + 4;
+            size_t contentLength = 0;
+            std::string_view cl = req.header("content-length");
+            if (!cl.empty()) contentLength = std::strtoul(std::string(cl).c_str(), nullptr, 10);
+
+            if (!req.header("transfer-encoding").empty()) {
+                reply.status = 411;
+            } else if (contentLength > MAX_BODY_BYTES) {
+                reply.status = 413;
+            } else {
+                while (buffer.size() < bodyStart + contentLength) {
+                    ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+                    if (n < 0 && errno == EINTR) continue;
+                    if (n <= 0) return;
+                    buffer.append(chunk, static_cast<size_t>(n));
+                }
+                req.body = buffer.substr(bodyStart, contentLength);
+                buffer.erase(0, bodyStart + contentLength);  // keep any pipelined bytes
+                if (const Route* stream = findStream(req)) {
+                    // The event stream owns the connection until the handler returns
+                    static const char head[] = "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\n"
+                        "Cache-Control: no-cache\r\nX-Accel-Buffering: no\r\nConnection: close\r\n\r\n";
+                    if (!sendAll(fd, head, sizeof(head) - 1)) return;
+                    HttpStream out(fd, running_);
+                    try {
+                        stream->stream(req, out);
+                    } catch (const std::exception& e) {
+                        logger.log(LOG_ERROR, "HttpServer stream " + req.path + " failed: " + e.what());
+                    }
+                    return;
+                }
+                keepAlive = lower(req.header("connection")) != "close";
+                reply = dispatch(req);
+            }
+        }
+
+        std::string out = "HTTP/1.1 " + std::to_string(reply.status) + " " + reasonPhrase(reply.status) + "\r\n";
+        if (reply.status != 204 && reply.status != 304) {
+            out += "Content-Type: " + reply.contentType + "\r\n";
+            out += "Content-Length: " + std::to_string(reply.body.size()) + "\r\n";
+        }
+        for (const auto& h : reply.headers) out += h.first + ": " + h.second + "\r\n";
+        out += keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+        if (req.method != "HEAD" && reply.status != 204 && reply.status != 304) out += reply.body;
+
+        if (!sendAll(fd, out.data(), out.size()) || !keepAlive) return;
+    }
+}
+
+const HttpServer::Route* HttpServer::findStream(const HttpRequest& request) const {
+    if (request.method != "GET") return nullptr;
+    for (const auto& r : routes_) {
+        if (r.stream && r.path == request.path) return &r;
+    }
+    return nullptr;
+}
+
+HttpReply HttpServer::dispatch(const HttpRequest& request) const {
+    auto invoke = [&request](const Handler& handler) {
+        try {
+            return handler(request);
+        } catch (const std::exception& e) {
+            logger.log(LOG_ERROR, "HttpServer handler for " + request.path + " failed: " + e.what());
+            HttpReply reply;
+            reply.status = 500;
+            return reply;
+        }
+    };
+
+    bool pathMatched = false;
+    for (const auto& r : routes_) {
+        if (r.path != request.path) continue;
+        pathMatched = true;
+        if (r.handler && (r.method == request.method || (request.method == "HEAD" && r.method == "GET"))) {
+            return invoke(r.handler);
+        }
+    }
+    if (!pathMatched && fallback_) {
+        return invoke(fallback_);
+    }
+    HttpReply reply;
+    reply.status = pathMatched ? 405 : 404;
+    reply.body = pathMatched ? "method not allowed\n" : "not found\n";
+    return reply;
+}
@@ -0,0 +1,130 @@
+// Contains the shared libcurl session
+#include "HttpSession.h"
+#include "logger.h"
+
+extern Logger logger;
+
+static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    ((std::string*)userp)->append((char*)contents, size * nmemb);
+    return size * nmemb;
+}
+
+HttpSession::HttpSession(bool verifyTls) : verifyTls_(verifyTls) {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    if (!verifyTls_) {
+        logger.log(LOG_WARNING, "TLS certificate verification is DISABLED; use this only with a local stand-in");
+    }
+
+    share_ = curl_share_init();
+    if (share_) {
+        curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, lockShare);
+        curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, unlockShare);
+        curl_share_setopt(share_, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    } else {
+        logger.log(LOG_WARNING, "Failed to create CURL share, connections will not be shared");
+    }
+
+    handle_ = newHandle();
+    if (!handle_) {
+        logger.log(LOG_ERROR, "Failed to initialize CURL");
+    }
+
+    const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+    const bool http2 = info && (info->features & CURL_VERSION_HTTP2);
+    logger.log(LOG_INFO, "HttpSession initialized (libcurl " + std::string(info ? info->version : "?") +
+        ", HTTP/2 " + (http2 ? "available" : "unavailable") + ")");
+}
+
+HttpSession::~HttpSession() {
+    if (handle_) curl_easy_cleanup(handle_);
+    if (share_) curl_share_cleanup(share_);
+    curl_global_cleanup();
+}
+
+void HttpSession::lockShare(CURL*, curl_lock_data data, curl_lock_access, void* userp) {
+    static_cast<HttpSession*>(userp)->shareLocks_[data].lock();
+}
+
+void HttpSession::unlockShare(CURL*, curl_lock_data data, void* userp) {
+    static_cast<HttpSession*>(userp)->shareLocks_[data].unlock();
+}
+
+void HttpSession::configure(CURL* handle) {
+    if (share_) curl_easy_setopt(handle, CURLOPT_SHARE, share_);
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);      // prefer multiplexing over a new connection
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");  // gzip/br if the server offers it
+    curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, verifyTls_ ? 1L : 0L);
+    curl_easy_setopt(handle, CURLOPT_SSL_VERIFYHOST, verifyTls_ ? 2L : 0L);
+}
+
+CURL* HttpSession::newHandle() {
+    CURL* handle = curl_easy_init();
+    if (handle) configure(handle);
+    return handle;
+}
+
+std::string HttpSession::escape(std::string_view value) {
+    char* encoded = curl_easy_escape(nullptr, value.data(), static_cast<int>(value.size()));
+    if (!encoded) {
+        logger.log(LOG_ERROR, "Failed to URL-encode value");
+        return std::string(value);
+    }
+    std::string result(encoded);
+    curl_free(encoded);
+    return result;
+}
+
+HttpResponse HttpSession::get(const std::string& url, const std::vector<std::string>& headers) {
+    return perform(url, nullptr, headers);
+}
+
+HttpResponse HttpSession::post(const std::string& url, const std::string& body,
+                               const std::vector<std::string>& headers) {
+    return perform(url, &body, headers);
+}
+
+HttpResponse HttpSession::perform(const std::string& url, const std::string* postBody,
+                                  const std::vector<std::string>& headers) {
+    HttpResponse response;
+    std::lock_guard<std::mutex> lock(handleMutex_);
+    if (!handle_) {
+        response.curlCode = CURLE_FAILED_INIT;
+        response.error = "CURL not initialized";
+        return response;
+    }
+
+    // Reset per-request options; the connection cache stays with the handle
+    curl_easy_reset(handle_);
+    configure(handle_);
+
+    struct curl_slist* headerList = nullptr;
+    for (const auto& h : headers) headerList = curl_slist_append(headerList, h.c_str());
+
+    curl_easy_setopt(handle_, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(handle_, CURLOPT_HTTPHEADER, headerList);
+    curl_easy_setopt(handle_, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(handle_, CURLOPT_WRITEDATA, &response.body);
+    if (postBody) {
+        curl_easy_setopt(handle_, CURLOPT_POSTFIELDS, postBody->c_str());
+        curl_easy_setopt(handle_, CURLOPT_POSTFIELDSIZE, (long)postBody->size());
+    }
+
+    response.curlCode = curl_easy_perform(handle_);
+    if (response.curlCode != CURLE_OK) {
+        response.error = curl_easy_strerror(response.curlCode);
+    } else {
+        curl_easy_getinfo(handle_, CURLINFO_RESPONSE_CODE, &response.status);
+        char* contentType = nullptr;
+        curl_easy_getinfo(handle_, CURLINFO_CONTENT_TYPE, &contentType);
+        if (contentType) response.contentType = contentType;
+    }
+
+    curl_slist_free_all(headerList);
+    return response;
+}
@@ -0,0 +1,27 @@
+#include "IngestEvents.h"
+
+void IngestEvents::notifyMailbox() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        mailboxChanged_ = true;
+    }
+    cv_.notify_one();
+}
+
+void IngestEvents::pushFrame(EmailContent frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        frames_.push_back(std::move(frame));
+    }
+    cv_.notify_one();
+}
+
+IngestEvents::Wake IngestEvents::waitFor(std::chrono::milliseconds timeout) {
+    Wake wake;
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake.timedOut = !cv_.wait_for(lock, timeout, [this] { return mailboxChanged_ || !frames_.empty(); });
+    wake.mailboxChanged = mailboxChanged_;
+    wake.frames.swap(frames_);
+    mailboxChanged_ = false;
+    return wake;
+}
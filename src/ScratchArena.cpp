@@ -0,0 +1,56 @@
+#include "ScratchArena.h"
+#include "logger.h"
+#include <algorithm>
+
+extern Logger logger;
+
+void* ScratchArena::SpillResource::do_allocate(size_t bytes, size_t alignment) {
+    ++allocations;
+    this->bytes += bytes;
+    cycleBytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void ScratchArena::SpillResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool ScratchArena::SpillResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+ScratchArena::ScratchArena(size_t blockBytes)
+    : block_(std::make_unique_for_overwrite<std::byte[]>(blockBytes)), blockBytes_(blockBytes) {
+    arena_.emplace(block_.get(), blockBytes_, &spill_);
+}
+
+void ScratchArena::reset() {
+    const size_t cycleBytes = blockBytes_ + spill_.cycleBytes;
+    arena_.reset();  // hands the spilled buffers back to the heap
+
+    // Size the block for the cycle that just spilled so the next one fits
+    if (spill_.cycleBytes > 0 && blockBytes_ < MAX_BLOCK_BYTES) {
+        blockBytes_ = std::min(cycleBytes, MAX_BLOCK_BYTES);
+        block_ = std::make_unique_for_overwrite<std::byte[]>(blockBytes_);
+        ++spill_.allocations;
+        spill_.bytes += blockBytes_;
+        ASCEND_LOG(LOG_DEBUG, "Scratch arena block grown to {} KiB", blockBytes_ / 1024);
+    }
+    spill_.cycleBytes = 0;
+    arena_.emplace(block_.get(), blockBytes_, &spill_);
+    ++resets_;
+}
+
+ScratchArena::Stats ScratchArena::stats() const {
+    Stats s;
+    s.blockBytes = blockBytes_;
+    s.resets = resets_;
+    s.heapAllocations = spill_.allocations;
+    s.heapBytes = spill_.bytes;
+    return s;
+}
+
+ScratchArena& ScratchArena::forThread() {
+    thread_local ScratchArena arena;
+    return arena;
+}
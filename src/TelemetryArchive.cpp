@@ -0,0 +1,255 @@
+#include "TelemetryArchive.h"
+#include "HexCodec.h"
+#include "logger.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+extern Logger logger;
+
+namespace {
+
+constexpr char MAGIC[8] = { 'A', 'S', 'C', 'N', 'D', 'A', 'R', 'C' };
+
+// CRC-32 (IEEE 802.3, same polynomial as zlib), table built at compile time
+constexpr std::array<uint32_t, 256> makeCrcTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> CRC_TABLE = makeCrcTable();
+
+uint32_t crc32(const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) c = CRC_TABLE[(c ^ p[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+template <typename T>
+uint32_t crcOf(const T& block) {
+    return crc32(&block, offsetof(T, crc));
+}
+
+template <size_t N>
+void copyText(char (&dst)[N], const std::string& src) {
+    std::memset(dst, 0, N);
+    std::memcpy(dst, src.data(), std::min(src.size(), N - 1));
+}
+
+template <size_t N>
+std::string readText(const char (&src)[N]) {
+    return std::string(src, strnlen(src, N));
+}
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = ::write(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+TelemetryArchive::TelemetryArchive(std::string path) : path_(std::move(path)) {}
+
+TelemetryArchive::~TelemetryArchive() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+bool TelemetryArchive::open() {
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        logger.log(LOG_ERROR, "Cannot open telemetry archive " + path_ + ": " + std::strerror(errno));
+        return false;
+    }
+
+    struct stat st{};
+    ::fstat(fd_, &st);
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+
+    if (fileSize == 0) {
+        ArchiveHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.headerSize = sizeof(ArchiveHeader);
+        header.recordSize = sizeof(ArchiveRecord);
+        header.crc = crcOf(header);
+        if (!writeAll(fd_, &header, sizeof(header)) || ::fdatasync(fd_) != 0) {
+            logger.log(LOG_ERROR, "Cannot write telemetry archive header to " + path_);
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        logger.log(LOG_INFO, "Created telemetry archive " + path_);
+        return true;
+    }
+
+    ArchiveHeader header{};
+    if (fileSize < sizeof(header) || ::pread(fd_, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.crc != crcOf(header) ||
+        header.version != VERSION || header.headerSize != sizeof(ArchiveHeader) ||
+        header.recordSize != sizeof(ArchiveRecord)) {
+        logger.log(LOG_ERROR, path_ + " is not a version " + std::to_string(VERSION) +
+            " telemetry archive, leaving it untouched");
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    const size_t body = fileSize - sizeof(ArchiveHeader);
+    records_ = body / sizeof(ArchiveRecord);
+    if (body % sizeof(ArchiveRecord) != 0) {
+        // Crash in the middle of an append: drop the partial record
+        const off_t whole = static_cast<off_t>(sizeof(ArchiveHeader) + records_ * sizeof(ArchiveRecord));
+        logger.log(LOG_WARNING, "Telemetry archive has a torn tail of " +
+            std::to_string(body % sizeof(ArchiveRecord)) + " bytes, truncating");
+        if (::ftruncate(fd_, whole) != 0) {
+            // Records appended after the torn bytes would be off the record
+            // grid; keep the archive read-only (replay still sees whole records)
+            logger.log(LOG_ERROR, "Cannot truncate telemetry archive (" + std::string(std::strerror(errno)) +
+                "), no appends this run");
+            misaligned_ = true;
+        }
+    }
+    return true;
+}
+
+bool TelemetryArchive::append(const EmailContent& t) {
+    if (fd_ < 0) return false;
+
+    ArchiveRecord record{};
+    copyText(record.imei, t.imei);
+    record.momsn = t.momsn;
+    record.sessionStatus = t.sessionStatus;
+    record.iridiumLatitude = t.iridiumLatitude;
+    record.iridiumLongitude = t.iridiumLongitude;
+    record.iridiumCep = t.iridiumCep;
+    copyText(record.transmitTime, t.transmitTime);
+
+    FrameBytes frame{};
+    HexCodec::Result hex = HexCodec::decode(t.hexData, frame);
+    std::memcpy(record.frame, frame.data(), sizeof(record.frame));
+    record.frameSize = static_cast<uint8_t>(hex.bytesWritten);
+    record.layout = static_cast<uint8_t>(t.payload.layout);
+    record.crc = crcOf(record);
+
+    // One write per record with O_APPEND, then sync: the record is on disk
+    // before append() returns, so callers can acknowledge the frame after it
+    std::lock_guard<std::mutex> lock(appendMutex_);
+    if (misaligned_) return false;
+    if (!writeAll(fd_, &record, sizeof(record)) || ::fdatasync(fd_) != 0) {
+        logger.log(LOG_ERROR, "Failed to append MOMSN " + std::to_string(t.momsn) + " to telemetry archive: " +
+            std::strerror(errno));
+        // Drop any partial record, or every later O_APPEND write would be
+        // off the record grid and fail its CRC on replay
+        const off_t good = static_cast<off_t>(sizeof(ArchiveHeader) + records_ * sizeof(ArchiveRecord));
+        if (::ftruncate(fd_, good) != 0) {
+            logger.log(LOG_ERROR, "Cannot truncate telemetry archive back to " + std::to_string(good) +
+                " bytes (" + std::strerror(errno) + "), no further appends");
+            misaligned_ = true;
+        }
+        return false;
+    }
+    ++records_;
+    return true;
+}
+
+size_t TelemetryArchive::replay(Decoder& decoder, TelemetryStore& store) {
+    if (fd_ < 0 || records_ == 0) return 0;
+    auto start = std::chrono::steady_clock::now();
+
+    const size_t mapped = sizeof(ArchiveHeader) + records_ * sizeof(ArchiveRecord);
+    void* base = ::mmap(nullptr, mapped, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (base == MAP_FAILED) {
+        logger.log(LOG_ERROR, "Cannot map telemetry archive: " + std::string(std::strerror(errno)));
+        return 0;
+    }
+    ::madvise(base, mapped, MADV_SEQUENTIAL);
+    const auto* records = reinterpret_cast<const ArchiveRecord*>(static_cast<const char*>(base) + sizeof(ArchiveHeader));
+
+    // Intact records, grouped by the layout they were decoded with
+    struct Group {
+        std::vector<size_t> index;
+        std::vector<FrameBytes> frames;
+        std::vector<PayloadData> payloads;
+    };
+    std::array<Group, static_cast<size_t>(TxLayoutVersion::Count)> groups;
+    std::deque<PayloadData> shortFrames;   // frames under 50 bytes, decoded one by one
+    std::vector<PayloadData*> payloadOf(records_, nullptr);
+    size_t corrupt = 0;
+
+    for (size_t i = 0; i < records_; ++i) {
+        const ArchiveRecord& r = records[i];
+        if (r.crc != crcOf(r) || r.layout >= groups.size() || r.frameSize > sizeof(r.frame)) {
+            ++corrupt;
+            continue;
+        }
+        if (r.frameSize < sizeof(r.frame)) {
+            payloadOf[i] = &shortFrames.emplace_back(
+                decoder.decodeFrame({ r.frame, r.frameSize }, static_cast<TxLayoutVersion>(r.layout)));
+            continue;
+        }
+        Group& g = groups[r.layout];
+        g.index.push_back(i);
+        FrameBytes& frame = g.frames.emplace_back();
+        std::memcpy(frame.data(), r.frame, frame.size());
+    }
+
+    for (size_t v = 0; v < groups.size(); ++v) {
+        Group& g = groups[v];
+        if (g.frames.empty()) continue;
+        g.payloads.resize(g.frames.size());
+        decoder.decodeBatch(g.frames, g.payloads, static_cast<TxLayoutVersion>(v));
+        for (size_t k = 0; k < g.index.size(); ++k) payloadOf[g.index[k]] = &g.payloads[k];
+    }
+
+    // Back into the store in archive (arrival) order
+    size_t appended = 0;
+    store.reserve(store.size() + records_);
+    for (size_t i = 0; i < records_; ++i) {
+        if (!payloadOf[i] || !payloadOf[i]->isValid) continue;
+        const ArchiveRecord& r = records[i];
+
+        EmailContent t;
+        t.isValid = true;
+        t.imei = readText(r.imei);
+        t.momsn = r.momsn;
+        if (store.contains(t.imei, t.momsn)) continue;
+        t.transmitTime = readText(r.transmitTime);
+        t.iridiumLatitude = r.iridiumLatitude;
+        t.iridiumLongitude = r.iridiumLongitude;
+        t.iridiumCep = r.iridiumCep;
+        t.sessionStatus = r.sessionStatus;
+        t.payload = std::move(*payloadOf[i]);
+
+        FrameBytes frame;
+        std::memcpy(frame.data(), r.frame, frame.size());
+        store.append(t, frame, r.frameSize);
+        ++appended;
+    }
+    ::munmap(base, mapped);
+
+    auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    logger.log(LOG_INFO, "Replayed " + std::to_string(appended) + " frame(s) from " + path_ + " in " +
+        std::to_string(ms) + " ms" + (corrupt ? " (" + std::to_string(corrupt) + " corrupt record(s) skipped)" : ""));
+    return appended;
+}
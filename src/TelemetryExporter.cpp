@@ -0,0 +1,230 @@
+#include "TelemetryExporter.h"
+#include "FrameRegistry.h"
+#include "logger.h"
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+
+using json = nlohmann::json;
+
+extern Logger logger;
+
+namespace {
+
+// Plotted measurement from its column, the rest from the re-projected frame
+json sensorToJson(const TelemetryStore& store, SensorSlot slot, size_t i, const AnalogSensor& decoded) {
+    AnalogSensor sensor = decoded;
+    sensor.measurement = store.columns().sensorMeasurement[slot][i];
+    return {
+        {"name", sensor.name()},
+        {"voltage", sensor.voltage},
+        {"measurement", sensor.measurement},
+        {"unit", sensor.unitString()},
+        {"isValid", sensor.isValid}
+    };
+}
+
+} // namespace
+
+TelemetryExporter::TelemetryExporter(std::string directory)
+    : ndjsonPath_(directory + "/telemetry.ndjson"),
+      manifestPath_(directory + "/telemetry.manifest.json") {
+    // History lives in memory, so each run starts a fresh file
+    std::ofstream truncate(ndjsonPath_, std::ios::trunc);
+    if (!truncate.is_open()) {
+        logger.log(LOG_ERROR, "Failed to open " + ndjsonPath_ + " for writing");
+    }
+    truncate.close();
+    manifestDirty_ = !publishManifest(0);
+}
+
+bool TelemetryExporter::exportNew(const TelemetryStore& store) {
+    if (store.size() <= exportedRecords_) {
+        if (manifestDirty_) manifestDirty_ = !publishManifest(exportedRecords_);
+        return false;
+    }
+
+    try {
+        if (ndjsonDirty_ && !truncateToExported()) return false;
+
+        std::string chunk;
+        for (size_t i = exportedRecords_; i < store.size(); ++i) {
+            // ASCII-only output keeps byte offsets equal to JS string offsets
+            chunk += rowToJson(store, i).dump(-1, ' ', true);
+            chunk += '\n';
+        }
+
+        std::ofstream file(ndjsonPath_, std::ios::app | std::ios::binary);
+        if (!file.is_open()) {
+            logger.log(LOG_ERROR, "Failed to open " + ndjsonPath_ + " for appending");
+            return false;
+        }
+        file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        file.close();
+        if (!file) {
+            logger.log(LOG_ERROR, "Failed to append to " + ndjsonPath_);
+            // Part of the chunk may have landed; the manifest offsets must stay exact
+            ndjsonDirty_ = true;
+            truncateToExported();
+            return false;
+        }
+
+        const size_t added = store.size() - exportedRecords_;
+        exportedBytes_ += chunk.size();
+        exportedRecords_ = store.size();
+        manifestDirty_ = !publishManifest(exportedRecords_);
+        if (manifestDirty_) return false;  // retried on the next call
+
+        logger.log(LOG_INFO, "Exported " + std::to_string(added) + " new record(s), " +
+            std::to_string(exportedRecords_) + " total");
+        return true;
+    } catch (const std::exception& e) {
+        logger.log(LOG_ERROR, "Error exporting to JSON: " + std::string(e.what()));
+        return false;
+    }
+}
+
+// Cuts the NDJSON file back to the bytes the manifest has published
+bool TelemetryExporter::truncateToExported() {
+    std::error_code ec;
+    std::filesystem::resize_file(ndjsonPath_, exportedBytes_, ec);
+    if (ec) {
+        logger.log(LOG_ERROR, "Failed to truncate " + ndjsonPath_ + " to " + std::to_string(exportedBytes_) +
+            " bytes: " + ec.message());
+        return false;
+    }
+    ndjsonDirty_ = false;
+    return true;
+}
+
+bool TelemetryExporter::publishManifest(size_t totalRecords) {
+    json manifest = {
+        {"lastUpdated", std::time(nullptr)},
+        {"totalRecords", totalRecords},
+        {"bytes", exportedBytes_}
+    };
+
+    const std::string tmpPath = manifestPath_ + ".tmp";
+    std::ofstream file(tmpPath, std::ios::trunc);
+    if (!file.is_open()) {
+        logger.log(LOG_ERROR, "Failed to open " + tmpPath + " for writing");
+        return false;
+    }
+    file << manifest.dump();
+    file.close();
+
+    if (!file || std::rename(tmpPath.c_str(), manifestPath_.c_str()) != 0) {
+        logger.log(LOG_ERROR, "Failed to publish " + manifestPath_);
+        return false;
+    }
+    return true;
+}
+
+json TelemetryExporter::rowToJson(const TelemetryStore& store, size_t i) {
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    const TelemetryColumns& c = store.columns();
+
+    std::string hexData;
+    hexData.reserve(c.frameSize[i] * 2);
+    for (size_t b = 0; b < c.frameSize[i]; ++b) {
+        hexData += HEX_DIGITS[c.frame[i][b] >> 4];
+        hexData += HEX_DIGITS[c.frame[i][b] & 0x0F];
+    }
+
+    // Fields without a column come from the frame
+    const PayloadData p = store.payload(i);
+    const char header[] = { p.header[0], p.header[1], '\0' };
+    const auto layout = static_cast<TxLayoutVersion>(c.layout[i]);
+
+    // Only valid records are stored
+    json entry = {
+        {"momsn", c.momsn[i]},
+        {"imei", store.str(c.imei[i])},
+        {"transmitTime", c.transmitTime[i]},
+        {"iridiumLatitude", c.iridiumLatitude[i]},
+        {"iridiumLongitude", c.iridiumLongitude[i]},
+        {"iridiumCep", c.iridiumCep[i]},
+        {"sessionStatus", c.sessionStatus[i]},
+        {"hexData", hexData},
+        {"isValid", true}
+    };
+
+    entry["payload"] = {
+        // Manufacturer header
+        {"header", header},
+        {"headerValid", p.headerValid},
+        {"serialNumber", p.serialNumber},
+
+        {"layout", FrameRegistry::versionName(layout)},
+
+        // GNSS
+        {"gnssValid", static_cast<bool>(c.gnssValid[i])},
+        {"gnssFaults", p.gnssFaults},
+        {"utcHours", p.utcHours},
+        {"utcMinutes", p.utcMinutes},
+        {"utcSeconds", p.utcSeconds},
+        {"latitude", c.latitude[i]},
+        {"longitude", c.longitude[i]},
+        {"altitude", c.altitude[i]},
+        {"altitudeUnits", altitudeUnitName(static_cast<AltitudeUnit>(c.altitudeUnits[i]))},
+
+        // AHT20
+        {"aht20", {
+            {"humidityRH", c.aht20HumidityRH[i]},
+            {"tempC", c.aht20TempC[i]},
+            {"tempF", p.aht20.tempF},
+            {"status", p.aht20.status},
+            {"statusString", p.aht20.statusString()},
+            {"isValid", p.aht20.isValid}
+        }},
+
+        // Radio
+        {"radio", {
+            {"stationIndex", p.radio.stationIndex},
+            {"frequencyMHz", p.radio.frequencyMHz},
+            {"signalStrength", p.radio.signalStrength},
+            {"stereo", p.radio.stereo},
+            {"peakSignal", p.radio.peakSignal},
+            {"sweepCount", p.radio.sweepCount}
+        }},
+
+        // Analog sensors
+        {"sensors", {
+            {"masterBattery", sensorToJson(store, SENSOR_MASTER_BATTERY, i, p.masterBattery)},
+            {"slaveBattery", sensorToJson(store, SENSOR_SLAVE_BATTERY, i, p.slaveBattery)},
+            {"internalTemp", sensorToJson(store, SENSOR_INTERNAL_TEMP, i, p.internalTemp)},
+            {"externalTemp", sensorToJson(store, SENSOR_EXTERNAL_TEMP, i, p.externalTemp)}
+        }},
+
+        // Modem
+        {"modem", {
+            {"currentCode", p.modem.currentCode},
+            {"currentDesc", Decoder::getModemStatusDescription(p.modem.currentCode)},
+            {"previousCode", p.modem.previousCode},
+            {"previousDesc", Decoder::getModemStatusDescription(p.modem.previousCode)},
+            {"i2cModemCode", p.modem.i2cModemCode}
+        }}
+    };
+
+    // Fields that only exist in one TX array revision
+    if (layout == TxLayoutVersion::V4_1) {
+        const FlightStatus& fs = p.flightStatus;
+        entry["payload"]["flightStatus"] = {
+            {"raw", fs.raw},
+            {"phase", fs.getPhaseString()},
+            {"btRxSuccess", fs.btRxSuccess},
+            {"btRxFailure", fs.btRxFailure},
+            {"balloonBurst", fs.balloonBurst},
+            {"descent", fs.descent},
+            {"ascent", fs.ascent},
+            {"landing", fs.landing}
+        };
+        entry["payload"]["recordSequence"] = p.recordSequence;
+        entry["payload"]["modem"]["txSuccessCount"] = p.modem.txSuccessCount;
+    } else {
+        entry["payload"]["datalinkByte"] = p.datalinkByte;
+        entry["payload"]["btLinkGood"] = static_cast<bool>(c.btLinkGood[i]);
+    }
+    return entry;
+}
@@ -0,0 +1,134 @@
+#include "TelemetryStore.h"
+#include "FrameRegistry.h"
+#include "HexCodec.h"
+#include <algorithm>
+#include <type_traits>
+
+// ============================================================
+//   STRING POOL / TEXT COLUMN
+// ============================================================
+
+uint32_t StringPool::intern(std::string_view s) {
+    auto it = ids_.find(s);
+    if (it != ids_.end()) return it->second;
+    const uint32_t id = static_cast<uint32_t>(strings_.size());
+    strings_.emplace_back(s);
+    ids_.emplace(strings_.back(), id);
+    return id;
+}
+
+bool StringPool::find(std::string_view s, uint32_t& id) const {
+    auto it = ids_.find(s);
+    if (it == ids_.end()) return false;
+    id = it->second;
+    return true;
+}
+
+void TextColumn::push_back(std::string_view s) {
+    data_.append(s);
+    ends_.push_back(static_cast<uint32_t>(data_.size()));
+}
+
+std::string_view TextColumn::operator[](size_t i) const {
+    const uint32_t begin = (i == 0) ? 0 : ends_[i - 1];
+    return std::string_view(data_).substr(begin, ends_[i] - begin);
+}
+
+void TextColumn::reserve(size_t records, size_t bytesPerRecord) {
+    data_.reserve(records * bytesPerRecord);
+    ends_.reserve(records);
+}
+
+// ============================================================
+//   TELEMETRY STORE
+// ============================================================
+
+namespace {
+
+// Applies f to every per-record vector, so append/reserve/size stay in step
+// with the column list.
+template <typename Columns, typename F>
+void forEachColumn(Columns& c, F&& f) {
+    f(c.momsn); f(c.imei); f(c.iridiumLatitude); f(c.iridiumLongitude);
+    f(c.iridiumCep); f(c.sessionStatus);
+
+    f(c.frame); f(c.frameSize); f(c.layout);
+
+    f(c.gnssValid); f(c.latitude); f(c.longitude); f(c.altitude); f(c.altitudeUnits);
+    f(c.btLinkGood); f(c.aht20TempC); f(c.aht20HumidityRH);
+    for (auto& m : c.sensorMeasurement) f(m);
+}
+
+constexpr size_t TRANSMIT_TIME_BYTES = 20;  // "2025-03-29T19:50:12Z"
+
+} // namespace
+
+void TelemetryStore::reserve(size_t records) {
+    forEachColumn(cols_, [records](auto& column) { column.reserve(records); });
+    frameKeys_.reserve(records);
+    cols_.transmitTime.reserve(records, TRANSMIT_TIME_BYTES);
+}
+
+size_t TelemetryStore::bytesPerRecord() const {
+    size_t bytes = 0;
+    forEachColumn(cols_, [&bytes](const auto& column) {
+        bytes += sizeof(typename std::decay_t<decltype(column)>::value_type);
+    });
+    return bytes + sizeof(uint32_t) + TRANSMIT_TIME_BYTES;
+}
+
+bool TelemetryStore::contains(std::string_view imei, int momsn) const {
+    uint32_t id = 0;
+    return strings_.find(imei, id) && frameKeys_.count(frameKey(id, momsn)) > 0;
+}
+
+PayloadData TelemetryStore::payload(size_t i) const {
+    PayloadData p;
+    const auto version = static_cast<TxLayoutVersion>(cols_.layout[i]);
+    const FrameRegistry::Entry* entry = FrameRegistry::find(version, cols_.frameSize[i]);
+    if (entry) entry->project(cols_.frame[i].data(), p);
+    return p;
+}
+
+void TelemetryStore::append(const EmailContent& t) {
+    // Keep the frame bytes rather than the hex text; hex is re-rendered on export
+    FrameBytes frame{};
+    HexCodec::Result r = HexCodec::decode(t.hexData, frame);
+    append(t, frame, r.bytesWritten);
+}
+
+void TelemetryStore::append(const EmailContent& t, const FrameBytes& frame, size_t frameSize) {
+    const PayloadData& p = t.payload;
+    TelemetryColumns& c = cols_;
+
+    const uint32_t imeiId = strings_.intern(t.imei);
+    frameKeys_.insert(frameKey(imeiId, t.momsn));
+    c.momsn.push_back(t.momsn);
+    c.imei.push_back(imeiId);
+    c.transmitTime.push_back(t.transmitTime);
+    c.iridiumLatitude.push_back(t.iridiumLatitude);
+    c.iridiumLongitude.push_back(t.iridiumLongitude);
+    c.iridiumCep.push_back(t.iridiumCep);
+    c.sessionStatus.push_back(t.sessionStatus);
+
+    c.frame.push_back(frame);
+    c.frameSize.push_back(static_cast<uint8_t>(std::min(frameSize, frame.size())));
+
+    c.layout.push_back(static_cast<uint8_t>(p.layout));
+
+    c.gnssValid.push_back(p.gnssValid);
+    c.latitude.push_back(p.latitude);
+    c.longitude.push_back(p.longitude);
+    c.altitude.push_back(p.altitude);
+    c.altitudeUnits.push_back(static_cast<uint8_t>(p.altitudeUnits));
+    c.btLinkGood.push_back(p.btLinkGood);
+    c.aht20TempC.push_back(p.aht20.tempC);
+    c.aht20HumidityRH.push_back(p.aht20.humidityRH);
+
+    const AnalogSensor* sensors[SENSOR_COUNT] = {
+        &p.masterBattery, &p.slaveBattery, &p.internalTemp, &p.externalTemp
+    };
+    for (size_t i = 0; i < SENSOR_COUNT; ++i) {
+        c.sensorMeasurement[i].push_back(sensors[i]->measurement);
+    }
+}
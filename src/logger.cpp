@@ -3,14 +3,12 @@
 #include <fstream>
 #include <iostream>
 #include <ctime>
-#include <deque>
+#include <cstdio>
+#include <cstring>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
-// Static members to store recent logs
-static std::deque<json> recentLogs;
-static const size_t MAX_LOGS = 500; 
 static std::string jsonLogPath = "dashboard/data/logs.json";
 
 Logger::Logger(const std::string filename, LogLevel level) {
@@ -19,81 +17,233 @@ Logger::Logger(const std::string filename, LogLevel level) {
     if (!logFile.is_open()) {
         std::cout << "[LOGGER] Could not open log file!" << std::endl;
     }
+    ring = std::make_unique<Slot[]>(RING_CAPACITY);
+    for (size_t i = 0; i < RING_CAPACITY; ++i) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    recent = std::make_unique<LogEntry[]>(RECENT_CAPACITY);
+    writer = std::thread(&Logger::writerLoop, this);
 }
 
 Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        running.store(false);
+    }
+    idleCv.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
     if(logFile.is_open()) {
         logFile.close();
     }
 }
 
-void Logger::log(LogLevel level, const std::string message) {
+// Bounded MPMC ring (Vyukov) used with a single consumer. A slot whose
+// sequence equals the claim position is free; producers claim with a CAS
+// on head, fill the record and publish by setting sequence = pos + 1.
+void Logger::log(LogLevel level, std::string message) {
     if (level < minLevel) {
         return;               
     }
-    
-    std::string timestamp = getTimestamp();
-    std::string levelStr = getLevelString(level);
-    std::string logMessage = "[" + timestamp + "] " + "[" + levelStr + "] " + message;
+
+    size_t pos = head.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &ring[pos & (RING_CAPACITY - 1)];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // Ring full: the writer is behind, wait for it rather than lose the line
+            std::this_thread::yield();
+            pos = head.load(std::memory_order_relaxed);
+        } else {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record.level = level;
+    slot->record.epochTime = time(nullptr);
+    slot->record.message = std::move(message);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    // The writer sets writerIdle before re-checking wakeups, so one of the
+    // two sides always sees the other (both are seq_cst)
+    wakeups.fetch_add(1);
+    if (writerIdle.load()) {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        idleCv.notify_one();
+    }
+}
+
+bool Logger::pop(Record& out) {
+    Slot& slot = ring[tail & (RING_CAPACITY - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+        return false;
+    }
+    out = std::move(slot.record);
+    slot.sequence.store(tail + RING_CAPACITY, std::memory_order_release);
+    ++tail;
+    return true;
+}
+
+void Logger::writerLoop() {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point nextExport = Clock::now();
+    Record record;
+    while (true) {
+        uint32_t seen = wakeups.load();
+        size_t drained = 0;
+        while (pop(record)) {
+            write(record);
+            ++drained;
+        }
+        if (drained > 0) {
+            // One flush per batch instead of one per line
+            if (logFile.is_open()) logFile.flush();
+            std::cout.flush();
+        }
+
+        const bool dirty = exportDirty;
+        if (dirty && Clock::now() >= nextExport) {
+            exportLogsToJson();
+            nextExport = Clock::now() + EXPORT_INTERVAL;
+        }
+        if (drained > 0) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idleMutex);
+        if (!running.load()) {
+            break;
+        }
+        writerIdle.store(true);
+        auto woken = [&] { return wakeups.load() != seen || !running.load(); };
+        if (dirty) {
+            idleCv.wait_until(lock, nextExport, woken);
+        } else {
+            idleCv.wait(lock, woken);
+        }
+        writerIdle.store(false);
+    }
+
+    // Final drain and export on shutdown
+    while (pop(record)) {
+        write(record);
+    }
+    if (logFile.is_open()) logFile.flush();
+    std::cout.flush();
+    if (exportDirty) {
+        exportLogsToJson();
+    }
+}
+
+void Logger::write(const Record& record) {
+    std::string timestamp = getTimestamp(record.epochTime);
+    std::string levelStr = getLevelString(record.level);
+    std::string logMessage = "[" + timestamp + "] " + "[" + levelStr + "] " + record.message;
     
     // Write to file
     if (logFile.is_open()) {
-        logFile << logMessage << std::endl;
-        logFile.flush(); // Ensure immediate write
+        logFile << logMessage << '\n';
     }
     
     // Write to console
-    if (level >= LOG_DEBUG) {
-        std::cout << logMessage << std::endl;
+    if (consoleOutput.load(std::memory_order_relaxed)) {
+        std::cout << logMessage << '\n';
     }
-    
-    // Store in memory for JSON export
-    json logEntry = {
-        {"timestamp", timestamp},
-        {"level", levelStr},
-        {"message", message},
-        {"epochTime", time(nullptr)}
-    };
-    
-    recentLogs.push_back(logEntry);
-    
-    // Keep only recent logs
-    if (recentLogs.size() > MAX_LOGS) {
-        recentLogs.pop_front();
+
+    remember(record);
+}
+
+// Appends to the recent-log ring, overwriting the oldest entry when full
+void Logger::remember(const Record& record) {
+    std::lock_guard<std::mutex> lock(recentMutex);
+    LogEntry& entry = recent[lastSeq % RECENT_CAPACITY];
+    entry.seq = ++lastSeq;
+    entry.epochTime = record.epochTime;
+    entry.level = static_cast<uint8_t>(record.level);
+    entry.truncated = record.message.size() > LogEntry::MESSAGE_BYTES;
+    entry.length = static_cast<uint16_t>(std::min(record.message.size(), LogEntry::MESSAGE_BYTES));
+    std::memcpy(entry.message, record.message.data(), entry.length);
+    exportDirty = true;
+}
+
+std::vector<LogEntry> Logger::logsSince(uint64_t afterSeq) const {
+    std::lock_guard<std::mutex> lock(recentMutex);
+    const uint64_t oldest = lastSeq > RECENT_CAPACITY ? lastSeq - RECENT_CAPACITY + 1 : 1;
+    uint64_t first = std::max(afterSeq + 1, oldest);
+    std::vector<LogEntry> out;
+    if (first > lastSeq) {
+        return out;
     }
-    
-    // Export to JSON periodically (every 10 logs to reduce I/O)
-    static int logCount = 0;
-    logCount++;
-    if (logCount >= 10) {
-        exportLogsToJson();
-        logCount = 0;
+    out.reserve(lastSeq - first + 1);
+    for (uint64_t seq = first; seq <= lastSeq; ++seq) {
+        out.push_back(recent[(seq - 1) % RECENT_CAPACITY]);
+    }
+    return out;
+}
+
+uint64_t Logger::latestSeq() const {
+    std::lock_guard<std::mutex> lock(recentMutex);
+    return lastSeq;
+}
+
+// { lastUpdated, lastSeq, totalLogs, logs: [ { seq, timestamp, level, message, epochTime } ] }
+// Same shape for logs.json and the dashboard's /logs endpoint
+std::string Logger::logsToJson(const std::vector<LogEntry>& entries, uint64_t latest) {
+    json logs = json::array();
+    for (const LogEntry& e : entries) {
+        std::string message(e.text());
+        if (e.truncated) message += "...";
+        logs.push_back({
+            {"seq", e.seq},
+            {"timestamp", getTimestamp(static_cast<time_t>(e.epochTime))},
+            {"level", getLevelString(static_cast<LogLevel>(e.level))},
+            {"message", message},
+            {"epochTime", e.epochTime}
+        });
     }
+    json output = {
+        {"lastUpdated", time(nullptr)},
+        {"lastSeq", latest},
+        {"totalLogs", logs.size()},
+        {"logs", logs}
+    };
+    // A cut message can end mid UTF-8 sequence
+    return output.dump(-1, ' ', false, json::error_handler_t::replace);
 }
 
+// Rewrites logs.json from the ring through a temp file and rename, so the
+// dashboard never reads a half-written file
 void Logger::exportLogsToJson() {
     try {
-        json output = {
-            {"lastUpdated", time(nullptr)},
-            {"totalLogs", recentLogs.size()},
-            {"logs", recentLogs}
-        };
-        
-        std::ofstream file(jsonLogPath);
-        if (file.is_open()) {
-            file << output.dump(2);
-            file.close();
+        std::vector<LogEntry> entries = logsSince(0);
+        std::string output = logsToJson(entries, entries.empty() ? 0 : entries.back().seq);
+        exportDirty = false;
+
+        const std::string tmpPath = jsonLogPath + ".tmp";
+        std::ofstream file(tmpPath, std::ios::trunc);
+        if (!file.is_open()) {
+            return;
+        }
+        file << output;
+        file.close();
+        if (!file || std::rename(tmpPath.c_str(), jsonLogPath.c_str()) != 0) {
+            std::cerr << "Error exporting logs to JSON: could not write " << jsonLogPath << std::endl;
         }
     } catch (const std::exception& e) {
         std::cerr << "Error exporting logs to JSON: " << e.what() << std::endl;
     }
 }
 
-std::string Logger::getTimestamp() {
-    time_t now = time(nullptr);
+std::string Logger::getTimestamp(time_t when) {
     char buffer[80];
-    struct tm * timeinfo = localtime(&now);
-    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeinfo);
+    struct tm timeinfo;
+    localtime_r(&when, &timeinfo);
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &timeinfo);
     return std::string(buffer);
 }
 
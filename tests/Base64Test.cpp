@@ -0,0 +1,187 @@
+#include "Base64.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+// ============================================================
+//   Base64 — SSSE3/AVX2 block decoders against the scalar path
+// ============================================================
+//   Every input is decoded once with Simd::None and once per block
+//   decoder level; status, error position and bytes must match, and
+//   nothing may be written past the output span.
+
+namespace {
+
+using Base64::Simd;
+
+constexpr size_t GUARD = 64;
+constexpr uint8_t GUARD_BYTE = 0xA5;
+
+constexpr char URL_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+constexpr char STD_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+struct Decoded {
+    Base64::Result result;
+    std::vector<uint8_t> bytes;
+};
+
+Decoded run(const std::string& text, size_t cap, Simd simd) {
+    std::vector<uint8_t> buffer(cap + GUARD, GUARD_BYTE);
+    Decoded d;
+    d.result = Base64::decode(text, std::span<uint8_t>(buffer.data(), cap), simd);
+    for (size_t i = cap; i < buffer.size(); ++i) {
+        EXPECT_EQ(buffer[i], GUARD_BYTE) << "wrote past the output span at +" << (i - cap);
+    }
+    d.bytes.assign(buffer.begin(), buffer.begin() + d.result.bytesWritten);
+    return d;
+}
+
+// Chars from both alphabets when `mixed`, otherwise from `alphabet` only
+std::string randomText(std::mt19937& rng, size_t length, const char* alphabet, bool mixed = false) {
+    std::uniform_int_distribution<size_t> pick(0, 63);
+    std::bernoulli_distribution coin(0.5);
+    std::string s(length, 'A');
+    for (char& c : s) c = (mixed && coin(rng) ? STD_ALPHABET : alphabet)[pick(rng)];
+    return s;
+}
+
+const char* simdName(Simd simd) {
+    switch (simd) {
+        case Simd::Ssse3: return "Ssse3";
+        case Simd::Avx2:  return "Avx2";
+        default:          return "None";
+    }
+}
+
+} // namespace
+
+namespace Base64 {
+void PrintTo(Simd simd, std::ostream* os) { *os << simdName(simd); }
+}
+
+namespace {
+
+class Base64Simd : public ::testing::TestWithParam<Simd> {
+protected:
+    void SetUp() override {
+        if (GetParam() > Base64::bestSimd()) GTEST_SKIP() << "CPU lacks " << simdName(GetParam());
+    }
+
+    void expectSameAsScalar(const std::string& text, size_t cap) {
+        const Decoded scalar = run(text, cap, Simd::None);
+        const Decoded simd = run(text, cap, GetParam());
+        SCOPED_TRACE("input \"" + text + "\", cap " + std::to_string(cap));
+        EXPECT_EQ(simd.result.status, scalar.result.status);
+        EXPECT_EQ(simd.result.errorPos, scalar.result.errorPos);
+        EXPECT_EQ(simd.result.bytesWritten, scalar.result.bytesWritten);
+        EXPECT_EQ(simd.bytes, scalar.bytes);
+    }
+};
+
+} // namespace
+
+TEST(Base64, DecodesBothAlphabetsWithOrWithoutPadding) {
+    uint8_t out[16] = {};
+    Base64::Result r = Base64::decode("SGVsbG8sIFdvcmxkIQ", out, Simd::None);
+    ASSERT_TRUE(r.ok());
+    EXPECT_EQ(std::string(reinterpret_cast<char*>(out), r.bytesWritten), "Hello, World!");
+
+    r = Base64::decode("SGVsbG8sIFdvcmxkIQ==", out, Simd::None);
+    ASSERT_TRUE(r.ok());
+    EXPECT_EQ(r.bytesWritten, 13u);
+
+    r = Base64::decode("-_-_", out, Simd::None);
+    ASSERT_TRUE(r.ok());
+    const uint8_t expected[] = { 0xFB, 0xFF, 0xBF };
+    EXPECT_TRUE(std::equal(std::begin(expected), std::end(expected), out));
+    r = Base64::decode("+/+/", out, Simd::None);
+    EXPECT_TRUE(std::equal(std::begin(expected), std::end(expected), out));
+}
+
+TEST(Base64, ScalarReportsErrorsByPosition) {
+    uint8_t out[8] = {};
+    Base64::Result r = Base64::decode("QUJD\r\nRE*F", out, Simd::None);
+    EXPECT_EQ(r.status, Base64::Status::InvalidChar);
+    EXPECT_EQ(r.errorPos, 8u);
+
+    r = Base64::decode("QUJDR", out, Simd::None);
+    EXPECT_EQ(r.status, Base64::Status::BadLength);
+    EXPECT_EQ(r.errorPos, 4u);
+
+    r = Base64::decode("QUJDREVGSElK", out, Simd::None);
+    EXPECT_EQ(r.status, Base64::Status::Overflow);
+    EXPECT_EQ(r.bytesWritten, 6u);
+}
+
+TEST(Base64, DecodeInPlaceShrinksTheString) {
+    std::string text = "SGVsbG8sIFdvcmxkIQ";
+    ASSERT_TRUE(Base64::decodeInPlace(text).ok());
+    EXPECT_EQ(text, "Hello, World!");
+}
+
+TEST_P(Base64Simd, RandomRunsOfEachAlphabet) {
+    std::mt19937 rng(20260318);
+    for (size_t length = 0; length <= 200; ++length) {
+        if (length % 4 == 1) continue;  // no valid encoding has this length
+        for (const char* alphabet : { URL_ALPHABET, STD_ALPHABET }) {
+            const std::string text = randomText(rng, length, alphabet);
+            expectSameAsScalar(text, Base64::decodedSize(length));
+            expectSameAsScalar(text, Base64::decodedSize(length) + 40);
+        }
+        expectSameAsScalar(randomText(rng, length, URL_ALPHABET, true), Base64::decodedSize(length) + 40);
+    }
+}
+
+TEST_P(Base64Simd, EveryAlphabetBoundaryInEveryLane) {
+    std::string text;
+    for (int rep = 0; rep < 8; ++rep) text += "AZaz09-_+/ZAzy9A";
+    expectSameAsScalar(text, Base64::decodedSize(text.size()));
+}
+
+TEST_P(Base64Simd, BadCharacterAtEveryPositionOfABlock) {
+    // Neighbours of the alphabet ranges, padding, whitespace, high bytes, NUL
+    const char bad[] = { '@', '[', '`', '{', '.', ',', '*', ':', '=', ' ', '\n', '\x7f', '\x80', '\xc3', '\xff', '\0' };
+    std::mt19937 rng(7);
+    const std::string clean = randomText(rng, 128, URL_ALPHABET);
+    for (char c : bad) {
+        for (size_t pos = 0; pos < 100; ++pos) {
+            std::string text = clean;
+            text[pos] = c;
+            expectSameAsScalar(text, 96);
+        }
+    }
+}
+
+TEST_P(Base64Simd, OutputJustTooSmall) {
+    std::mt19937 rng(11);
+    for (size_t length : { 16u, 20u, 32u, 36u, 48u, 64u, 68u, 96u }) {
+        const std::string text = randomText(rng, length, URL_ALPHABET);
+        for (size_t cap = 0; cap <= Base64::decodedSize(length); ++cap) expectSameAsScalar(text, cap);
+    }
+}
+
+TEST_P(Base64Simd, WrappedLinesAndPadding) {
+    std::mt19937 rng(13);
+    const std::string line = randomText(rng, 76, STD_ALPHABET);
+    expectSameAsScalar(line + "\r\n" + line + "\r\n" + line.substr(0, 38) + "==", 200);
+    expectSameAsScalar(randomText(rng, 66, URL_ALPHABET) + "=", 64);
+    expectSameAsScalar(randomText(rng, 33, URL_ALPHABET), 64);
+}
+
+TEST_P(Base64Simd, InPlaceMatchesScalar) {
+    std::mt19937 rng(17);
+    for (size_t length : { 31u, 32u, 64u, 100u, 1000u }) {
+        const std::string text = randomText(rng, length, URL_ALPHABET, true);
+        std::string a = text;
+        std::string b = text;
+        const Base64::Result ra = Base64::decode(a, std::span<uint8_t>(reinterpret_cast<uint8_t*>(a.data()), a.size()), Simd::None);
+        const Base64::Result rb = Base64::decode(b, std::span<uint8_t>(reinterpret_cast<uint8_t*>(b.data()), b.size()), GetParam());
+        EXPECT_EQ(ra.status, rb.status);
+        EXPECT_EQ(ra.bytesWritten, rb.bytesWritten);
+        EXPECT_EQ(a.substr(0, ra.bytesWritten), b.substr(0, rb.bytesWritten));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Levels, Base64Simd, ::testing::Values(Simd::Ssse3, Simd::Avx2),
+    [](const ::testing::TestParamInfo<Simd>& info) { return std::string(simdName(info.param)); });
@@ -0,0 +1,151 @@
+#include "GmailBatch.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// ============================================================
+//   GmailBatch — multipart/mixed request and reply framing
+// ============================================================
+//   Replies are built the way the batch endpoint (and the stand-in in
+//   scripts/gmail_standin.py) writes them: parts in any order, each an
+//   embedded HTTP response tagged <response-itemN>.
+
+namespace {
+
+const std::string CONTENT_TYPE = "multipart/mixed; boundary=batch_reply_b7";
+
+std::string part(const std::string& contentId, int status, const std::string& body) {
+    return "--batch_reply_b7\r\n"
+           "Content-Type: application/http\r\n"
+           "Content-ID: " + contentId + "\r\n\r\n"
+           "HTTP/1.1 " + std::to_string(status) + " X\r\n"
+           "Content-Type: application/json; charset=UTF-8\r\n\r\n" +
+           body + "\r\n";
+}
+
+const std::string CLOSE = "--batch_reply_b7--\r\n";
+
+std::string toLf(std::string s) {
+    std::string out;
+    for (char c : s) if (c != '\r') out += c;
+    return out;
+}
+
+} // namespace
+
+TEST(GmailBatch, UrlPath) {
+    EXPECT_EQ(GmailBatch::urlPath("https://gmail.googleapis.com/gmail/v1/users/me"), "/gmail/v1/users/me");
+    EXPECT_EQ(GmailBatch::urlPath("https://127.0.0.1:8443/gmail/v1/users/me"), "/gmail/v1/users/me");
+    EXPECT_EQ(GmailBatch::urlPath("https://example.com"), "");
+}
+
+TEST(GmailBatch, BoundaryParameter) {
+    EXPECT_EQ(GmailBatch::boundaryFrom("multipart/mixed; boundary=batch_x"), "batch_x");
+    EXPECT_EQ(GmailBatch::boundaryFrom("multipart/mixed; boundary=batch_x; charset=UTF-8"), "batch_x");
+    EXPECT_EQ(GmailBatch::boundaryFrom("multipart/mixed; boundary=\"batch x;y\""), "batch x;y");
+    EXPECT_EQ(GmailBatch::boundaryFrom("multipart/mixed; boundary=\"batch_x\"; charset=UTF-8"), "batch_x");
+    EXPECT_EQ(GmailBatch::boundaryFrom("Multipart/Mixed; BOUNDARY=Batch_X"), "Batch_X");
+    EXPECT_EQ(GmailBatch::boundaryFrom("application/json"), "");
+}
+
+TEST(GmailBatch, RequestBodyRoundTrips) {
+    const std::vector<std::string> ids = {"skip", "m1", "m2", "m3"};
+    const std::string body = GmailBatch::buildBody("/gmail/v1/users/me", ids, 1, 3);
+    EXPECT_NE(body.find("GET /gmail/v1/users/me/messages/m2?format=full\r\n"), std::string::npos);
+    EXPECT_EQ(body.find("skip"), std::string::npos);
+
+    std::vector<GmailBatch::Item> items;
+    ASSERT_TRUE(GmailBatch::demux("multipart/mixed; boundary=" + GmailBatch::BOUNDARY, body, items));
+    ASSERT_EQ(items.size(), 3u);
+    for (size_t i = 0; i < items.size(); ++i) {
+        EXPECT_EQ(items[i].index, i);
+        EXPECT_EQ(items[i].status, 0);  // requests, not responses
+    }
+}
+
+TEST(GmailBatch, MatchesResponseContentIds) {
+    const std::string reply = part("<response-item2>", 200, "{\"id\":\"m3\"}") +
+                              part("<response-item0>", 200, "{\"id\":\"m1\"}") +
+                              part("<response-item1>", 200, "{\"id\":\"m2\"}") + CLOSE;
+    std::vector<GmailBatch::Item> items;
+    ASSERT_TRUE(GmailBatch::demux(CONTENT_TYPE, reply, items));
+    ASSERT_EQ(items.size(), 3u);
+    EXPECT_EQ(items[0].index, 2u);
+    EXPECT_EQ(items[0].body, "{\"id\":\"m3\"}");
+    EXPECT_EQ(items[1].index, 0u);
+    EXPECT_EQ(items[2].index, 1u);
+    EXPECT_EQ(items[2].status, 200);
+}
+
+TEST(GmailBatch, PlainItemIdsAndMissingContentId) {
+    const std::string reply = part("<item12>", 200, "{}") +
+                              "--batch_reply_b7\r\nContent-Type: application/http\r\n\r\nHTTP/1.1 200 OK\r\n\r\n{}\r\n" +
+                              CLOSE;
+    std::vector<GmailBatch::Item> items;
+    ASSERT_TRUE(GmailBatch::demux(CONTENT_TYPE, reply, items));
+    ASSERT_EQ(items.size(), 2u);
+    EXPECT_EQ(items[0].index, 12u);
+    EXPECT_EQ(items[1].index, 1u);  // no Content-ID: position in the reply
+}
+
+TEST(GmailBatch, LfLineEndingsMatchCrlf) {
+    const std::string reply = part("<response-item1>", 200, "{\"id\":\"m2\"}") +
+                              part("<response-item0>", 404, "{\"error\":{\"code\":404}}") + CLOSE;
+    std::vector<GmailBatch::Item> crlf, lf;
+    const std::string lfReply = toLf(reply);
+    ASSERT_TRUE(GmailBatch::demux(CONTENT_TYPE, reply, crlf));
+    ASSERT_TRUE(GmailBatch::demux(CONTENT_TYPE, lfReply, lf));
+    ASSERT_EQ(crlf.size(), 2u);
+    ASSERT_EQ(lf.size(), crlf.size());
+    for (size_t i = 0; i < crlf.size(); ++i) {
+        EXPECT_EQ(lf[i].index, crlf[i].index);
+        EXPECT_EQ(lf[i].status, crlf[i].status);
+        EXPECT_EQ(lf[i].body, crlf[i].body);
+    }
+}
+
+TEST(GmailBatch, QuotedBoundaryInReply) {
+    const std::string reply = part("<response-item0>", 200, "{}") + CLOSE;
+    std::vector<GmailBatch::Item> items;
+    ASSERT_TRUE(GmailBatch::demux("multipart/mixed; boundary=\"batch_reply_b7\"", reply, items));
+    EXPECT_EQ(items.size(), 1u);
+}
+
+TEST(GmailBatch, UnauthorizedItemInsideOkBatch) {
+    const std::string error = "{\"error\":{\"code\":401,\"message\":\"Invalid Credentials\"}}";
+    const std::string reply = part("<response-item0>", 200, "{\"id\":\"m1\"}") +
+                              part("<response-item1>", 401, error) + CLOSE;
+    std::vector<GmailBatch::Item> items;
+    ASSERT_TRUE(GmailBatch::demux(CONTENT_TYPE, reply, items));
+    ASSERT_EQ(items.size(), 2u);
+    EXPECT_EQ(items[1].index, 1u);
+    EXPECT_EQ(items[1].status, 401);
+    EXPECT_EQ(items[1].body, error);
+}
+
+TEST(GmailBatch, MissingClosingDelimiter) {
+    const std::string reply = part("<response-item0>", 200, "{}") + part("<response-item1>", 200, "{}");
+    std::vector<GmailBatch::Item> items;
+    EXPECT_FALSE(GmailBatch::demux(CONTENT_TYPE, reply, items));
+}
+
+TEST(GmailBatch, TruncatedPart) {
+    const std::string reply = part("<response-item0>", 200, "{}") + "--batch_reply_b7\r\nContent-Type: appl";
+    std::vector<GmailBatch::Item> items;
+    EXPECT_FALSE(GmailBatch::demux(CONTENT_TYPE, reply, items));
+}
+
+TEST(GmailBatch, MissingBoundary) {
+    std::vector<GmailBatch::Item> items;
+    EXPECT_FALSE(GmailBatch::demux("multipart/mixed", part("<response-item0>", 200, "{}") + CLOSE, items));
+    EXPECT_TRUE(items.empty());
+}
+
+TEST(GmailBatch, DelimiterTextInsideBodyIsNotASplit) {
+    const std::string body = "{\"snippet\":\"see --batch_reply_b7 here\"}";
+    const std::string reply = "preamble text\r\n" + part("<response-item0>", 200, body) + CLOSE;
+    std::vector<GmailBatch::Item> items;
+    ASSERT_TRUE(GmailBatch::demux(CONTENT_TYPE, reply, items));
+    ASSERT_EQ(items.size(), 1u);
+    EXPECT_EQ(items[0].body, body);
+}
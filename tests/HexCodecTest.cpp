@@ -0,0 +1,154 @@
+#include "HexCodec.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+// ============================================================
+//   HexCodec — SIMD block decoders against the scalar table path
+// ============================================================
+//   Every input is decoded once with Simd::None and once per block
+//   decoder level; status, error position and bytes must match, and
+//   nothing may be written past the output span.
+
+namespace {
+
+using HexCodec::Simd;
+
+constexpr size_t GUARD = 64;
+constexpr uint8_t GUARD_BYTE = 0xA5;
+
+struct Decoded {
+    HexCodec::Result result;
+    std::vector<uint8_t> bytes;
+};
+
+Decoded run(const std::string& hex, size_t cap, Simd simd) {
+    std::vector<uint8_t> buffer(cap + GUARD, GUARD_BYTE);
+    Decoded d;
+    d.result = HexCodec::decode(hex, std::span<uint8_t>(buffer.data(), cap), simd);
+    for (size_t i = cap; i < buffer.size(); ++i) {
+        EXPECT_EQ(buffer[i], GUARD_BYTE) << "wrote past the output span at +" << (i - cap);
+    }
+    d.bytes.assign(buffer.begin(), buffer.begin() + d.result.bytesWritten);
+    return d;
+}
+
+std::string randomHex(std::mt19937& rng, size_t digits) {
+    static constexpr char DIGITS[] = "0123456789abcdefABCDEF";
+    std::uniform_int_distribution<size_t> pick(0, sizeof(DIGITS) - 2);
+    std::string s(digits, '0');
+    for (char& c : s) c = DIGITS[pick(rng)];
+    return s;
+}
+
+const char* simdName(Simd simd) {
+    switch (simd) {
+        case Simd::Sse2: return "Sse2";
+        case Simd::Avx2: return "Avx2";
+        default:         return "None";
+    }
+}
+
+} // namespace
+
+namespace HexCodec {
+void PrintTo(Simd simd, std::ostream* os) { *os << simdName(simd); }
+}
+
+namespace {
+
+class HexCodecSimd : public ::testing::TestWithParam<Simd> {
+protected:
+    void SetUp() override {
+        if (GetParam() > HexCodec::bestSimd()) GTEST_SKIP() << "CPU lacks " << simdName(GetParam());
+    }
+
+    void expectSameAsScalar(const std::string& hex, size_t cap) {
+        const Decoded scalar = run(hex, cap, Simd::None);
+        const Decoded simd = run(hex, cap, GetParam());
+        SCOPED_TRACE("input \"" + hex + "\", cap " + std::to_string(cap));
+        EXPECT_EQ(simd.result.status, scalar.result.status);
+        EXPECT_EQ(simd.result.errorPos, scalar.result.errorPos);
+        EXPECT_EQ(simd.result.bytesWritten, scalar.result.bytesWritten);
+        EXPECT_EQ(simd.bytes, scalar.bytes);
+    }
+};
+
+} // namespace
+
+TEST(HexCodec, DecodesKnownFrameStart) {
+    uint8_t out[8] = {};
+    const HexCodec::Result r = HexCodec::decode("524203561101160f", out, Simd::None);
+    ASSERT_TRUE(r.ok());
+    ASSERT_EQ(r.bytesWritten, 8u);
+    const uint8_t expected[] = { 0x52, 0x42, 0x03, 0x56, 0x11, 0x01, 0x16, 0x0f };
+    EXPECT_TRUE(std::equal(std::begin(expected), std::end(expected), out));
+}
+
+TEST(HexCodec, ScalarReportsErrorsByPosition) {
+    uint8_t out[4] = {};
+    HexCodec::Result r = HexCodec::decode("12 3g", out, Simd::None);
+    EXPECT_EQ(r.status, HexCodec::Status::InvalidChar);
+    EXPECT_EQ(r.errorPos, 4u);
+    EXPECT_EQ(r.bytesWritten, 1u);
+
+    r = HexCodec::decode("12\r\n3", out, Simd::None);
+    EXPECT_EQ(r.status, HexCodec::Status::OddDigits);
+    EXPECT_EQ(r.errorPos, 4u);
+
+    r = HexCodec::decode("0102030405", out, Simd::None);
+    EXPECT_EQ(r.status, HexCodec::Status::Overflow);
+    EXPECT_EQ(r.errorPos, 8u);
+    EXPECT_EQ(r.bytesWritten, 4u);
+}
+
+TEST_P(HexCodecSimd, RandomMixedCaseRuns) {
+    std::mt19937 rng(20260318);
+    for (size_t digits = 0; digits <= 260; digits += 2) {
+        const std::string hex = randomHex(rng, digits);
+        expectSameAsScalar(hex, digits / 2);
+        expectSameAsScalar(hex, digits / 2 + 40);
+    }
+}
+
+TEST_P(HexCodecSimd, EveryCaseOfEveryLetter) {
+    // Boundaries of the digit and letter ranges in both cases, in every lane
+    std::string hex;
+    for (int rep = 0; rep < 8; ++rep) hex += "09afAF90FAfa0a9F";
+    expectSameAsScalar(hex, hex.size() / 2);
+}
+
+TEST_P(HexCodecSimd, BadCharacterAtEveryPositionOfABlock) {
+    // Just outside the hex ranges, high bytes, NUL and whitespace (which
+    // the blocks reject and the scalar path skips)
+    const char bad[] = { 'g', 'G', '/', ':', '@', '`', '\x7f', '\x80', '\xb0', '\xff', '\0', ' ', '\n' };
+    std::mt19937 rng(7);
+    const std::string clean = randomHex(rng, 160);
+    for (char c : bad) {
+        for (size_t pos = 0; pos < 130; ++pos) {
+            std::string hex = clean;
+            hex[pos] = c;
+            expectSameAsScalar(hex, 80);
+        }
+    }
+}
+
+TEST_P(HexCodecSimd, OutputJustTooSmall) {
+    std::mt19937 rng(11);
+    for (size_t digits : { 32u, 34u, 64u, 66u, 96u, 100u, 128u, 130u }) {
+        const std::string hex = randomHex(rng, digits);
+        for (size_t cap = 0; cap <= digits / 2; ++cap) expectSameAsScalar(hex, cap);
+    }
+}
+
+TEST_P(HexCodecSimd, OddLengthAndWrappedLines) {
+    std::mt19937 rng(13);
+    const std::string line = randomHex(rng, 76);
+    expectSameAsScalar(line + "\r\n" + line + "\r\n" + line.substr(0, 33), 200);
+    expectSameAsScalar(randomHex(rng, 65), 64);
+    expectSameAsScalar(randomHex(rng, 129), 64);
+}
+
+INSTANTIATE_TEST_SUITE_P(Levels, HexCodecSimd, ::testing::Values(Simd::Sse2, Simd::Avx2),
+    [](const ::testing::TestParamInfo<Simd>& info) { return std::string(simdName(info.param)); });
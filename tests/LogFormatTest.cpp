@@ -0,0 +1,47 @@
+#include "LogFormat.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+
+// ============================================================
+//   LogFormat — the "{}" subset ASCEND_LOG formats through
+// ============================================================
+
+TEST(LogFormat, IntegersPrintInDecimal) {
+    EXPECT_EQ(LogFormat::format("n={}", 42), "n=42");
+    EXPECT_EQ(LogFormat::format("n={}", -7), "n=-7");
+    EXPECT_EQ(LogFormat::format("{}", std::numeric_limits<int64_t>::min()), "-9223372036854775808");
+    EXPECT_EQ(LogFormat::format("{}", std::numeric_limits<uint64_t>::max()), "18446744073709551615");
+}
+
+TEST(LogFormat, SmallIntegersAreNumbersNotCharacters) {
+    EXPECT_EQ(LogFormat::format("{}", static_cast<uint8_t>(65)), "65");
+    EXPECT_EQ(LogFormat::format("{}", static_cast<int8_t>(-3)), "-3");
+    EXPECT_EQ(LogFormat::format("{}", 'A'), "A");
+}
+
+TEST(LogFormat, HexAndPadding) {
+    EXPECT_EQ(LogFormat::format("0x{:02X}", static_cast<uint8_t>(0x0b)), "0x0B");
+    EXPECT_EQ(LogFormat::format("{:x}", 0xBEEFu), "beef");
+    EXPECT_EQ(LogFormat::format("[{:4}]", 7), "[   7]");
+    EXPECT_EQ(LogFormat::format("[{:04}]", 7), "[0007]");
+}
+
+TEST(LogFormat, ZeroPaddedNegativeKeepsSignFirst) {
+    EXPECT_EQ(LogFormat::format("{:05}", -42), "-0042");
+    EXPECT_EQ(LogFormat::format("{:03}", -1234), "-1234");
+}
+
+TEST(LogFormat, FloatsMatchToString) {
+    EXPECT_EQ(LogFormat::format("{}", 7.5), std::to_string(7.5));
+    EXPECT_EQ(LogFormat::format("{}", 20.820236f), std::to_string(20.820236f));
+    EXPECT_EQ(LogFormat::format("{:.2f}", 3.14159), "3.14");
+}
+
+TEST(LogFormat, StringsBoolsAndBraces) {
+    const std::string s = "abc";
+    EXPECT_EQ(LogFormat::format("{} {} {}", s, std::string_view("de"), "f"), "abc de f");
+    EXPECT_EQ(LogFormat::format("{}/{}", true, false), "true/false");
+    EXPECT_EQ(LogFormat::format("{{{}}}", 1), "{1}");
+    EXPECT_EQ(LogFormat::format("{}", static_cast<const char*>(nullptr)), "(null)");
+}
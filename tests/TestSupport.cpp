@@ -0,0 +1,5 @@
+#include "logger.h"
+
+// ascend_core logs through this global; tests only want errors, and
+// those go nowhere
+Logger logger("/dev/null", LOG_ERROR);